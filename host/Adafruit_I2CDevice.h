@@ -0,0 +1,8 @@
+#ifndef HOST_ADAFRUIT_I2CDEVICE_H
+#define HOST_ADAFRUIT_I2CDEVICE_H
+
+// Adafruit BusIO no se compila en el host (lib_ignore); Adafruit_GFX.h
+// solo necesita que la cabecera exista
+class Adafruit_I2CDevice;
+
+#endif
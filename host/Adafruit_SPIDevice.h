@@ -0,0 +1,7 @@
+#ifndef HOST_ADAFRUIT_SPIDEVICE_H
+#define HOST_ADAFRUIT_SPIDEVICE_H
+
+// Ver Adafruit_I2CDevice.h
+class Adafruit_SPIDevice;
+
+#endif
@@ -0,0 +1,246 @@
+#include "Adafruit_SSD1306.h"
+
+Adafruit_SSD1306::Adafruit_SSD1306(uint8_t w, uint8_t h, TwoWire* twi, int8_t rst_pin,
+                                   uint32_t clkDuring, uint32_t clkAfter)
+    : Adafruit_GFX(w, h), spi(nullptr), wire(twi ? twi : &Wire), buffer(nullptr),
+      i2caddr(0), vccstate(0), page_end(0), mosiPin(-1), clkPin(-1), dcPin(-1),
+      csPin(-1), rstPin(rst_pin), wireClk(clkDuring), restoreClk(clkAfter),
+      contrast(0), fullFrames(0) {
+}
+
+Adafruit_SSD1306::~Adafruit_SSD1306(void) {
+  free(buffer);
+  buffer = nullptr;
+}
+
+bool Adafruit_SSD1306::begin(uint8_t vcs, uint8_t addr, bool reset, bool periphBegin) {
+  if (!buffer && !(buffer = (uint8_t*)malloc(WIDTH * ((HEIGHT + 7) / 8)))) {
+    return false;
+  }
+  clearDisplay();
+  
+  vccstate = vcs;
+  i2caddr = addr ? addr : ((HEIGHT == 32) ? 0x3C : 0x3D);
+  page_end = (HEIGHT + 7) / 8 - 1;
+  if (periphBegin) wire->begin();
+  
+  // Mismo orden de inicialización que la librería original (lo relevante
+  // para el modelo del panel es el modo horizontal y el encendido)
+  contrast = (vccstate == SSD1306_EXTERNALVCC) ? 0x9F : 0xCF;
+  const uint8_t init[] = {
+    SSD1306_DISPLAYOFF,
+    SSD1306_SETDISPLAYCLOCKDIV, 0x80,
+    SSD1306_SETMULTIPLEX, (uint8_t)(HEIGHT - 1),
+    SSD1306_SETDISPLAYOFFSET, 0x00,
+    SSD1306_SETSTARTLINE | 0x0,
+    SSD1306_CHARGEPUMP, (uint8_t)((vccstate == SSD1306_EXTERNALVCC) ? 0x10 : 0x14),
+    SSD1306_MEMORYMODE, 0x00,
+    SSD1306_SEGREMAP | 0x1,
+    SSD1306_COMSCANDEC,
+    SSD1306_SETCOMPINS, 0x12,
+    SSD1306_SETCONTRAST, contrast,
+    SSD1306_SETPRECHARGE, (uint8_t)((vccstate == SSD1306_EXTERNALVCC) ? 0x22 : 0xF1),
+    SSD1306_SETVCOMDETECT, 0x40,
+    SSD1306_DISPLAYALLON_RESUME,
+    SSD1306_NORMALDISPLAY,
+    SSD1306_DISPLAYON
+  };
+  wire->setClock(wireClk);
+  ssd1306_commandList(init, sizeof(init));
+  wire->setClock(restoreClk);
+  return true;
+}
+
+void Adafruit_SSD1306::ssd1306_command1(uint8_t c) {
+  wire->beginTransmission(i2caddr);
+  wire->write((uint8_t)0x00);
+  wire->write(c);
+  wire->endTransmission();
+}
+
+void Adafruit_SSD1306::ssd1306_commandList(const uint8_t* c, uint8_t n) {
+  wire->beginTransmission(i2caddr);
+  wire->write((uint8_t)0x00);
+  uint16_t bytesOut = 1;
+  while (n--) {
+    if (bytesOut >= I2C_BUFFER_LENGTH) {
+      wire->endTransmission();
+      wire->beginTransmission(i2caddr);
+      wire->write((uint8_t)0x00);
+      bytesOut = 1;
+    }
+    wire->write(*c++);
+    bytesOut++;
+  }
+  wire->endTransmission();
+}
+
+void Adafruit_SSD1306::ssd1306_command(uint8_t c) {
+  wire->setClock(wireClk);
+  ssd1306_command1(c);
+  wire->setClock(restoreClk);
+}
+
+void Adafruit_SSD1306::display(void) {
+  fullFrames++;
+  const uint8_t dlist[] = {
+    SSD1306_PAGEADDR, 0, 0xFF,
+    SSD1306_COLUMNADDR, 0, (uint8_t)(WIDTH - 1)
+  };
+  wire->setClock(wireClk);
+  ssd1306_commandList(dlist, sizeof(dlist));
+  
+  uint16_t count = WIDTH * ((HEIGHT + 7) / 8);
+  const uint8_t* ptr = buffer;
+  wire->beginTransmission(i2caddr);
+  wire->write((uint8_t)0x40);
+  uint16_t bytesOut = 1;
+  while (count--) {
+    if (bytesOut >= I2C_BUFFER_LENGTH) {
+      wire->endTransmission();
+      wire->beginTransmission(i2caddr);
+      wire->write((uint8_t)0x40);
+      bytesOut = 1;
+    }
+    wire->write(*ptr++);
+    bytesOut++;
+  }
+  wire->endTransmission();
+  wire->setClock(restoreClk);
+}
+
+void Adafruit_SSD1306::clearDisplay(void) {
+  memset(buffer, 0, WIDTH * ((HEIGHT + 7) / 8));
+}
+
+void Adafruit_SSD1306::invertDisplay(bool i) {
+  ssd1306_command(i ? SSD1306_INVERTDISPLAY : SSD1306_NORMALDISPLAY);
+}
+
+void Adafruit_SSD1306::dim(bool dim) {
+  const uint8_t cmd[] = { SSD1306_SETCONTRAST, (uint8_t)(dim ? 0 : contrast) };
+  wire->setClock(wireClk);
+  ssd1306_commandList(cmd, sizeof(cmd));
+  wire->setClock(restoreClk);
+}
+
+void Adafruit_SSD1306::drawPixel(int16_t x, int16_t y, uint16_t color) {
+  if ((x < 0) || (x >= width()) || (y < 0) || (y >= height())) return;
+  
+  int16_t t;
+  switch (getRotation()) {
+  case 1:
+    t = x; x = WIDTH - y - 1; y = t;
+    break;
+  case 2:
+    x = WIDTH - x - 1; y = HEIGHT - y - 1;
+    break;
+  case 3:
+    t = x; x = y; y = HEIGHT - t - 1;
+    break;
+  }
+  
+  uint8_t* b = &buffer[x + (y / 8) * WIDTH];
+  uint8_t bit = 1 << (y & 7);
+  switch (color) {
+  case SSD1306_WHITE: *b |= bit; break;
+  case SSD1306_BLACK: *b &= ~bit; break;
+  case SSD1306_INVERSE: *b ^= bit; break;
+  }
+}
+
+void Adafruit_SSD1306::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+  bool bSwap = false;
+  switch (getRotation()) {
+  case 1:
+    bSwap = true;
+    { int16_t t = x; x = WIDTH - 1 - y; y = t; }
+    break;
+  case 2:
+    x = WIDTH - 1 - x - (w - 1);
+    y = HEIGHT - 1 - y;
+    break;
+  case 3:
+    bSwap = true;
+    { int16_t t = x; x = y; y = HEIGHT - 1 - t - (w - 1); }
+    break;
+  }
+  if (bSwap) drawFastVLineInternal(x, y, w, color);
+  else drawFastHLineInternal(x, y, w, color);
+}
+
+void Adafruit_SSD1306::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+  bool bSwap = false;
+  switch (getRotation()) {
+  case 1:
+    bSwap = true;
+    { int16_t t = x; x = WIDTH - 1 - y - (h - 1); y = t; }
+    break;
+  case 2:
+    x = WIDTH - 1 - x;
+    y = HEIGHT - 1 - y - (h - 1);
+    break;
+  case 3:
+    bSwap = true;
+    { int16_t t = x; x = y; y = HEIGHT - 1 - t; }
+    break;
+  }
+  if (bSwap) drawFastHLineInternal(x, y, h, color);
+  else drawFastVLineInternal(x, y, h, color);
+}
+
+void Adafruit_SSD1306::drawFastHLineInternal(int16_t x, int16_t y, int16_t w, uint16_t color) {
+  if ((y < 0) || (y >= HEIGHT)) return;
+  if (x < 0) { w += x; x = 0; }
+  if ((x + w) > WIDTH) w = WIDTH - x;
+  if (w <= 0) return;
+  
+  uint8_t* p = &buffer[(y / 8) * WIDTH + x];
+  uint8_t mask = 1 << (y & 7);
+  while (w--) {
+    switch (color) {
+    case SSD1306_WHITE: *p |= mask; break;
+    case SSD1306_BLACK: *p &= ~mask; break;
+    case SSD1306_INVERSE: *p ^= mask; break;
+    }
+    p++;
+  }
+}
+
+void Adafruit_SSD1306::drawFastVLineInternal(int16_t x, int16_t y, int16_t h, uint16_t color) {
+  if ((x < 0) || (x >= WIDTH)) return;
+  if (y < 0) { h += y; y = 0; }
+  if ((y + h) > HEIGHT) h = HEIGHT - y;
+  if (h <= 0) return;
+  
+  for (int16_t yy = y; yy < y + h; yy++) {
+    uint8_t* p = &buffer[(yy / 8) * WIDTH + x];
+    uint8_t mask = 1 << (yy & 7);
+    switch (color) {
+    case SSD1306_WHITE: *p |= mask; break;
+    case SSD1306_BLACK: *p &= ~mask; break;
+    case SSD1306_INVERSE: *p ^= mask; break;
+    }
+  }
+}
+
+bool Adafruit_SSD1306::getPixel(int16_t x, int16_t y) {
+  if ((x < 0) || (x >= width()) || (y < 0) || (y >= height())) return false;
+  int16_t t;
+  switch (getRotation()) {
+  case 1:
+    t = x; x = WIDTH - y - 1; y = t;
+    break;
+  case 2:
+    x = WIDTH - x - 1; y = HEIGHT - y - 1;
+    break;
+  case 3:
+    t = x; x = y; y = HEIGHT - t - 1;
+    break;
+  }
+  return (buffer[x + (y / 8) * WIDTH] & (1 << (y & 7)));
+}
+
+uint8_t* Adafruit_SSD1306::getBuffer(void) {
+  return buffer;
+}
@@ -0,0 +1,95 @@
+/*
+ * Entorno Arduino mínimo para compilar el firmware en Linux (env:native).
+ * Solo cubre lo que usan el firmware, RoboEyes y Adafruit GFX.
+ */
+
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <string>
+#include "Print.h"
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#define HIGH 1
+#define LOW 0
+#define INPUT 0x01
+#define OUTPUT 0x03
+#define INPUT_PULLUP 0x05
+#define RISING 0x01
+#define FALLING 0x02
+#define CHANGE 0x03
+#define DEFAULT 0
+
+#define PROGMEM
+#define IRAM_ATTR
+#define F(s) (reinterpret_cast<const __FlashStringHelper*>(s))
+#ifndef pgm_read_byte
+#define pgm_read_byte(addr) (*(const uint8_t*)(addr))
+#define pgm_read_word(addr) (*(const uint16_t*)(addr))
+#define pgm_read_dword(addr) (*(const uint32_t*)(addr))
+#define pgm_read_pointer(addr) (*(void* const*)(addr))
+#endif
+
+// Logs de ESP-IDF redirigidos a stdout
+#define log_e(fmt, ...) printf("[E] " fmt "\n", ##__VA_ARGS__)
+#define log_w(fmt, ...) printf("[W] " fmt "\n", ##__VA_ARGS__)
+#define log_i(fmt, ...) do { if (hostLogEnabled) printf("[I] " fmt "\n", ##__VA_ARGS__); } while (0)
+#define log_d(fmt, ...) do { } while (0)
+extern bool hostLogEnabled;
+
+class __FlashStringHelper;
+
+class String {
+private:
+  std::string str;
+public:
+  String(const char* s = "") : str(s) {}
+  unsigned int length() const { return str.length(); }
+  const char* c_str() const { return str.c_str(); }
+};
+
+// Tiempo
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+void yield();
+
+// Aleatorios (misma firma que Arduino)
+long random(long howbig);
+long random(long howsmall, long howbig);
+void randomSeed(unsigned long seed);
+
+// GPIO y buzzer: sin hardware, no hacen nada
+void pinMode(uint8_t pin, uint8_t mode);
+int digitalRead(uint8_t pin);
+void digitalWrite(uint8_t pin, uint8_t val);
+void tone(uint8_t pin, unsigned int frequency, unsigned long duration = 0);
+void noTone(uint8_t pin);
+#define digitalPinToInterrupt(p) (p)
+void attachInterrupt(uint8_t pin, void (*handler)(void), int mode);
+void detachInterrupt(uint8_t pin);
+
+template<class T, class U> auto min(const T& a, const U& b) -> decltype(a < b ? a : b) { return (a < b) ? a : b; }
+template<class T, class U> auto max(const T& a, const U& b) -> decltype(a < b ? a : b) { return (a > b) ? a : b; }
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+class HostSerial : public Print {
+public:
+  void begin(unsigned long) {}
+  void setDebugOutput(bool) {}
+  operator bool() const { return true; }
+  size_t write(uint8_t c) override { return fputc(c, stdout) == EOF ? 0 : 1; }
+  using Print::write;
+};
+extern HostSerial Serial;
+
+#endif
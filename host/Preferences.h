@@ -0,0 +1,26 @@
+#ifndef HOST_PREFERENCES_H
+#define HOST_PREFERENCES_H
+
+#include <Arduino.h>
+
+// NVS simulada en memoria: los valores viven mientras dura el proceso
+class Preferences {
+private:
+  std::string ns;
+  bool readOnly;
+  
+public:
+  Preferences() : readOnly(false) {}
+  bool begin(const char* name, bool readOnly = false);
+  void end();
+  
+  size_t putInt(const char* key, int32_t value);
+  int32_t getInt(const char* key, int32_t defaultValue = 0);
+  size_t putBool(const char* key, bool value);
+  bool getBool(const char* key, bool defaultValue = false);
+  bool clear();
+  
+  static void resetAll();  // Borra todos los namespaces
+};
+
+#endif
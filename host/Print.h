@@ -0,0 +1,35 @@
+#ifndef HOST_PRINT_H
+#define HOST_PRINT_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+class __FlashStringHelper;
+class String;
+
+// Subconjunto de Print de Arduino (lo que usan Adafruit GFX y el firmware)
+class Print {
+public:
+  virtual ~Print() {}
+  virtual size_t write(uint8_t c) = 0;
+  virtual size_t write(const uint8_t* buffer, size_t size);
+  size_t write(const char* str) { return str ? write((const uint8_t*)str, strlen(str)) : 0; }
+  
+  size_t print(const __FlashStringHelper* s);
+  size_t print(const String& s);
+  size_t print(const char* s) { return write(s); }
+  size_t print(char c) { return write((uint8_t)c); }
+  size_t print(int n) { return print((long)n); }
+  size_t print(unsigned int n) { return print((unsigned long)n); }
+  size_t print(long n);
+  size_t print(unsigned long n);
+  size_t print(double n, int digits = 2);
+  
+  size_t println() { return write("\r\n"); }
+  template<typename T> size_t println(T value) { size_t n = print(value); return n + println(); }
+  
+  size_t printf(const char* format, ...) __attribute__((format(printf, 2, 3)));
+};
+
+#endif
@@ -0,0 +1,7 @@
+#ifndef HOST_SPI_H
+#define HOST_SPI_H
+
+// Sin bus SPI en el host; solo existe para satisfacer cabeceras de Adafruit
+class SPIClass;
+
+#endif
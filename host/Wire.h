@@ -0,0 +1,45 @@
+#ifndef HOST_WIRE_H
+#define HOST_WIRE_H
+
+#include <Arduino.h>
+#include "hostpanel.h"
+
+#define I2C_BUFFER_LENGTH 128
+
+// Bus I2C simulado con un SSD1306 conectado: cuenta el tráfico y entrega
+// cada transacción al modelo del panel
+class TwoWire {
+private:
+  uint8_t txBuffer[I2C_BUFFER_LENGTH];
+  size_t txLength;
+  uint8_t txAddress;
+  uint32_t clock;
+  
+  unsigned long bytesWritten;  // Incluye el byte de dirección de cada transacción
+  unsigned long transactions;
+  unsigned long long busNanos;  // Al reloj vigente en cada transacción
+  
+public:
+  HostPanel panel;
+  
+  TwoWire();
+  bool begin(int sda = -1, int scl = -1, uint32_t frequency = 0);
+  void setClock(uint32_t frequency) { clock = frequency; }
+  uint32_t getClock() const { return clock; }
+  
+  void beginTransmission(uint8_t address);
+  size_t write(uint8_t data);
+  size_t write(const uint8_t* data, size_t quantity);
+  uint8_t endTransmission(bool sendStop = true);
+  
+  unsigned long getBytesWritten() const { return bytesWritten; }
+  unsigned long getTransactions() const { return transactions; }
+  // Tiempo que tardaría el tráfico en un bus real (9 ciclos de reloj por byte,
+  // con el reloj fijado durante cada transacción)
+  unsigned long getBusMicros() const;
+  void resetStats();
+};
+
+extern TwoWire Wire;
+
+#endif
@@ -0,0 +1,234 @@
+/*
+ * Implementación del entorno Arduino para el host: tiempo, aleatorios,
+ * Print, bus I2C simulado y NVS en memoria.
+ */
+
+#include <Arduino.h>
+#include <Wire.h>
+#include <Preferences.h>
+#include <stdarg.h>
+#include <chrono>
+#include <thread>
+#include <map>
+
+bool hostLogEnabled = true;
+HostSerial Serial;
+TwoWire Wire;
+
+// ==================== TIEMPO ====================
+
+static const std::chrono::steady_clock::time_point bootTime = std::chrono::steady_clock::now();
+
+unsigned long millis() {
+  return (unsigned long)std::chrono::duration_cast<std::chrono::milliseconds>(
+    std::chrono::steady_clock::now() - bootTime).count();
+}
+
+unsigned long micros() {
+  return (unsigned long)std::chrono::duration_cast<std::chrono::microseconds>(
+    std::chrono::steady_clock::now() - bootTime).count();
+}
+
+void delay(unsigned long ms) {
+  std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+void delayMicroseconds(unsigned int us) {
+  std::this_thread::sleep_for(std::chrono::microseconds(us));
+}
+
+void yield() {
+}
+
+// ==================== ALEATORIOS ====================
+
+long random(long howbig) {
+  if (howbig <= 0) return 0;
+  return rand() % howbig;
+}
+
+long random(long howsmall, long howbig) {
+  if (howsmall >= howbig) return howsmall;
+  return howsmall + random(howbig - howsmall);
+}
+
+void randomSeed(unsigned long seed) {
+  if (seed != 0) srand(seed);
+}
+
+// ==================== GPIO ====================
+
+void pinMode(uint8_t pin, uint8_t mode) {
+}
+
+int digitalRead(uint8_t pin) {
+  return HIGH;  // Botones con pull-up: sin pulsar
+}
+
+void digitalWrite(uint8_t pin, uint8_t val) {
+}
+
+void tone(uint8_t pin, unsigned int frequency, unsigned long duration) {
+}
+
+void noTone(uint8_t pin) {
+}
+
+void attachInterrupt(uint8_t pin, void (*handler)(void), int mode) {
+}
+
+void detachInterrupt(uint8_t pin) {
+}
+
+// ==================== PRINT ====================
+
+size_t Print::write(const uint8_t* buffer, size_t size) {
+  size_t n = 0;
+  while (size--) {
+    if (write(*buffer++)) n++;
+    else break;
+  }
+  return n;
+}
+
+size_t Print::print(const __FlashStringHelper* s) {
+  return write((const char*)s);
+}
+
+size_t Print::print(const String& s) {
+  return write(s.c_str());
+}
+
+size_t Print::print(long n) {
+  char buf[24];
+  snprintf(buf, sizeof(buf), "%ld", n);
+  return write(buf);
+}
+
+size_t Print::print(unsigned long n) {
+  char buf[24];
+  snprintf(buf, sizeof(buf), "%lu", n);
+  return write(buf);
+}
+
+size_t Print::print(double n, int digits) {
+  char buf[48];
+  snprintf(buf, sizeof(buf), "%.*f", digits, n);
+  return write(buf);
+}
+
+size_t Print::printf(const char* format, ...) {
+  char buf[256];
+  va_list args;
+  va_start(args, format);
+  int len = vsnprintf(buf, sizeof(buf), format, args);
+  va_end(args);
+  if (len < 0) return 0;
+  return write((const uint8_t*)buf, (size_t)len < sizeof(buf) ? len : sizeof(buf) - 1);
+}
+
+// ==================== WIRE ====================
+
+TwoWire::TwoWire() {
+  txLength = 0;
+  txAddress = 0;
+  clock = 100000;
+  bytesWritten = 0;
+  transactions = 0;
+  busNanos = 0;
+}
+
+bool TwoWire::begin(int sda, int scl, uint32_t frequency) {
+  if (frequency != 0) clock = frequency;
+  return true;
+}
+
+void TwoWire::beginTransmission(uint8_t address) {
+  txAddress = address;
+  txLength = 0;
+}
+
+size_t TwoWire::write(uint8_t data) {
+  if (txLength >= I2C_BUFFER_LENGTH) return 0;
+  txBuffer[txLength++] = data;
+  return 1;
+}
+
+size_t TwoWire::write(const uint8_t* data, size_t quantity) {
+  size_t n = 0;
+  while (n < quantity && write(data[n])) n++;
+  return n;
+}
+
+uint8_t TwoWire::endTransmission(bool sendStop) {
+  bytesWritten += txLength + 1;
+  transactions++;
+  busNanos += (unsigned long long)(txLength + 1) * 9 * 1000000000ULL / clock;
+  
+  if (txAddress != HOST_PANEL_ADDRESS) {
+    txLength = 0;
+    return 2;  // NACK en la dirección, como un bus real sin ese dispositivo
+  }
+  panel.receive(txBuffer, txLength);
+  txLength = 0;
+  return 0;
+}
+
+unsigned long TwoWire::getBusMicros() const {
+  // Cada byte son 8 bits más ACK; start/stop se desprecian
+  return (unsigned long)(busNanos / 1000);
+}
+
+void TwoWire::resetStats() {
+  bytesWritten = 0;
+  transactions = 0;
+  busNanos = 0;
+}
+
+// ==================== PREFERENCES ====================
+
+static std::map<std::string, std::map<std::string, int32_t>>& nvsStore() {
+  static std::map<std::string, std::map<std::string, int32_t>> store;
+  return store;
+}
+
+bool Preferences::begin(const char* name, bool ro) {
+  ns = name;
+  readOnly = ro;
+  return true;
+}
+
+void Preferences::end() {
+  ns.clear();
+}
+
+size_t Preferences::putInt(const char* key, int32_t value) {
+  if (readOnly || ns.empty()) return 0;
+  nvsStore()[ns][key] = value;
+  return sizeof(value);
+}
+
+int32_t Preferences::getInt(const char* key, int32_t defaultValue) {
+  auto space = nvsStore().find(ns);
+  if (space == nvsStore().end()) return defaultValue;
+  auto entry = space->second.find(key);
+  return entry == space->second.end() ? defaultValue : entry->second;
+}
+
+size_t Preferences::putBool(const char* key, bool value) {
+  return putInt(key, value ? 1 : 0) ? 1 : 0;
+}
+
+bool Preferences::getBool(const char* key, bool defaultValue) {
+  return getInt(key, defaultValue ? 1 : 0) != 0;
+}
+
+bool Preferences::clear() {
+  if (readOnly || ns.empty()) return false;
+  nvsStore()[ns].clear();
+  return true;
+}
+
+void Preferences::resetAll() {
+  nvsStore().clear();
+}
@@ -0,0 +1,138 @@
+#include "hostpanel.h"
+#include <string.h>
+
+HostPanel::HostPanel() {
+  reset();
+}
+
+void HostPanel::reset() {
+  memset(gddram, 0, sizeof(gddram));
+  colStart = 0;
+  colEnd = HOST_PANEL_WIDTH - 1;
+  pageStart = 0;
+  pageEnd = HOST_PANEL_PAGES - 1;
+  col = 0;
+  page = 0;
+  contrast = 0x7F;
+  displayOn = false;
+  pendingCommand = 0;
+  pendingArgs = 0;
+  argCount = 0;
+  dataBytes = 0;
+  commandBytes = 0;
+}
+
+void HostPanel::receive(const uint8_t* bytes, size_t length) {
+  if (length == 0) return;
+  
+  // Byte de control: bit 6 (D/C#) indica datos o comandos para el resto
+  bool isData = bytes[0] & 0x40;
+  for (size_t i = 1; i < length; i++) {
+    if (isData) {
+      data(bytes[i]);
+    } else {
+      command(bytes[i]);
+    }
+  }
+}
+
+void HostPanel::command(uint8_t c) {
+  commandBytes++;
+  
+  if (pendingArgs > 0) {
+    args[argCount++] = c;
+    if (argCount == pendingArgs) {
+      applyCommand();
+      pendingArgs = 0;
+    }
+    return;
+  }
+  
+  // Número de argumentos de cada comando según la hoja de datos
+  uint8_t argsNeeded = 0;
+  switch (c) {
+    case 0x20: case 0x81: case 0x8D: case 0xA8: case 0xD3:
+    case 0xD5: case 0xD9: case 0xDA: case 0xDB:
+      argsNeeded = 1;
+      break;
+    case 0x21: case 0x22: case 0xA3:
+      argsNeeded = 2;
+      break;
+    case 0x29: case 0x2A:
+      argsNeeded = 5;
+      break;
+    case 0x26: case 0x27:
+      argsNeeded = 6;
+      break;
+    case 0xAE:
+      displayOn = false;
+      break;
+    case 0xAF:
+      displayOn = true;
+      break;
+  }
+  
+  if (argsNeeded > 0) {
+    pendingCommand = c;
+    pendingArgs = argsNeeded;
+    argCount = 0;
+  }
+}
+
+void HostPanel::applyCommand() {
+  switch (pendingCommand) {
+    case 0x21:  // COLUMNADDR
+      colStart = args[0] & 0x7F;
+      colEnd = args[1] & 0x7F;
+      col = colStart;
+      break;
+    case 0x22:  // PAGEADDR (la librería envía 0xFF como "hasta el final")
+      pageStart = args[0] & 0x07;
+      pageEnd = args[1] & 0x07;
+      page = pageStart;
+      break;
+    case 0x81:  // SETCONTRAST
+      contrast = args[0];
+      break;
+  }
+}
+
+void HostPanel::data(uint8_t d) {
+  dataBytes++;
+  gddram[page * HOST_PANEL_WIDTH + col] = d;
+  
+  // Direccionamiento horizontal: avanza columna y salta de página al final de la ventana
+  if (col >= colEnd) {
+    col = colStart;
+    page = (page >= pageEnd) ? pageStart : page + 1;
+  } else {
+    col++;
+  }
+}
+
+bool HostPanel::getPixel(int x, int y) const {
+  if (x < 0 || x >= HOST_PANEL_WIDTH || y < 0 || y >= HOST_PANEL_PAGES * 8) return false;
+  return gddram[(y / 8) * HOST_PANEL_WIDTH + x] & (1 << (y & 7));
+}
+
+bool HostPanel::savePBM(const char* path) const {
+  FILE* f = fopen(path, "wb");
+  if (f == nullptr) return false;
+  
+  fprintf(f, "P4\n%d %d\n", HOST_PANEL_WIDTH, HOST_PANEL_PAGES * 8);
+  for (int y = 0; y < HOST_PANEL_PAGES * 8; y++) {
+    for (int x = 0; x < HOST_PANEL_WIDTH; x += 8) {
+      uint8_t packed = 0;
+      for (int bit = 0; bit < 8; bit++) {
+        // En PBM 1 = negro; un píxel encendido se guarda como blanco
+        if (!getPixel(x + bit, y)) packed |= 0x80 >> bit;
+      }
+      fputc(packed, f);
+    }
+  }
+  return fclose(f) == 0;
+}
+
+bool HostPanel::appendRaw(FILE* stream) const {
+  return fwrite(gddram, 1, sizeof(gddram), stream) == sizeof(gddram);
+}
@@ -0,0 +1,55 @@
+#ifndef HOST_PANEL_H
+#define HOST_PANEL_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+#define HOST_PANEL_ADDRESS 0x3C
+#define HOST_PANEL_WIDTH 128
+#define HOST_PANEL_PAGES 8
+
+// Modelo del controlador SSD1306: interpreta el flujo de comandos y datos
+// recibido por I2C y mantiene la GDDRAM tal y como la mostraría el panel.
+// Permite comprobar que los envíos parciales dejan la pantalla correcta.
+class HostPanel {
+private:
+  uint8_t gddram[HOST_PANEL_WIDTH * HOST_PANEL_PAGES];
+  uint8_t colStart, colEnd, pageStart, pageEnd;
+  uint8_t col, page;
+  uint8_t contrast;
+  bool displayOn;
+  
+  // Comando multibyte en curso
+  uint8_t pendingCommand;
+  uint8_t pendingArgs;
+  uint8_t args[6];
+  uint8_t argCount;
+  
+  unsigned long dataBytes;
+  unsigned long commandBytes;
+  
+public:
+  HostPanel();
+  void reset();
+  
+  // Una transacción I2C completa (byte de control + carga)
+  void receive(const uint8_t* data, size_t length);
+  
+  const uint8_t* getGddram() const { return gddram; }
+  bool getPixel(int x, int y) const;
+  uint8_t getContrast() const { return contrast; }
+  bool isDisplayOn() const { return displayOn; }
+  unsigned long getDataBytes() const { return dataBytes; }
+  unsigned long getCommandBytes() const { return commandBytes; }
+  
+  // Volcado de la pantalla: PBM (P4) o 1024 bytes en crudo por frame
+  bool savePBM(const char* path) const;
+  bool appendRaw(FILE* stream) const;
+  
+private:
+  void command(uint8_t c);
+  void applyCommand();
+  void data(uint8_t d);
+};
+
+#endif
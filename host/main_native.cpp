@@ -0,0 +1,179 @@
+/*
+ * Punto de entrada del host (env:native).
+ * Recorre las pantallas del firmware con el DisplayManager real y graba cada
+ * frame tal y como lo recibe el panel simulado:
+ *
+ *   tamagotchi_host [--frames N] [--out DIR] [--raw FICHERO] [--quiet]
+ *   tamagotchi_host --bench [FRAMES]
+ *   tamagotchi_host --soak DIAS [--games N] [--seed S]
+ *
+ *   --frames N     iteraciones de la pantalla principal (por defecto 120)
+ *   --out DIR      guarda cada frame enviado como DIR/frame_NNNN.pbm
+ *   --raw FICHERO  añade cada frame como 1024 bytes de GDDRAM (formato página)
+ *   --bench        ejecuta el benchmark de render (RenderBenchmark) y termina
+ *   --soak DIAS    simula DIAS de vida de la mascota y N partidas de cada juego
+ *                  (por defecto 1000) con reloj virtual y semilla S, y termina
+ *
+ * Además comprueba que tras cada envío la GDDRAM del panel coincide con el
+ * buffer, lo que valida el envío por páginas modificadas.
+ *
+ * Los ojos usan un reloj manual y un generador con semilla fija: cada frame
+ * de la pantalla principal avanza el intervalo que daría pacedFrameInterval()
+ * con el tiempo de bus simulado del frame anterior, y la grabación sale igual
+ * en cada ejecución (y sin esperar en tiempo real).
+ */
+
+#include <Arduino.h>
+#include <Wire.h>
+#include "tamagotchi.h"
+#include "oled.h"
+#include "display.h"
+#include "benchmark.h"
+#include "governor.h"
+#include "clock.h"
+#include "soak.h"
+
+OledDisplay display(&Wire);
+Tamagotchi pet;
+DisplayManager displayMgr;
+ManualClock eyesClock;
+SeededRng eyesRng(1);
+
+static const char* outDir = nullptr;
+static FILE* rawStream = nullptr;
+static unsigned long recordedFrames = 0;
+static unsigned long mismatchedFrames = 0;
+static unsigned long lastFlushCount = 0;
+
+// Graba el frame si commitFrame() lo ha enviado al panel
+static void recordFrame() {
+  if (display.getFramesFlushed() == lastFlushCount) return;
+  lastFlushCount = display.getFramesFlushed();
+  
+  if (memcmp(Wire.panel.getGddram(), display.getBuffer(), OLED_WIDTH * OLED_PAGES) != 0) {
+    mismatchedFrames++;
+  }
+  
+  if (outDir != nullptr) {
+    char path[512];
+    snprintf(path, sizeof(path), "%s/frame_%04lu.pbm", outDir, recordedFrames);
+    if (!Wire.panel.savePBM(path)) {
+      log_e("No se pudo escribir %s", path);
+    }
+  }
+  if (rawStream != nullptr) {
+    Wire.panel.appendRaw(rawStream);
+  }
+  recordedFrames++;
+}
+
+static void commit() {
+  displayMgr.commitFrame();
+  recordFrame();
+}
+
+int main(int argc, char** argv) {
+  int mainFrames = 120;
+  int benchFrames = 0;
+  bool soak = false;
+  SoakOptions soakOptions = { 0, 1000, 1 };
+  
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+      mainFrames = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "--out") == 0 && i + 1 < argc) {
+      outDir = argv[++i];
+    } else if (strcmp(argv[i], "--raw") == 0 && i + 1 < argc) {
+      rawStream = fopen(argv[++i], "wb");
+      if (rawStream == nullptr) {
+        log_e("No se pudo abrir %s", argv[i]);
+        return 1;
+      }
+    } else if (strcmp(argv[i], "--bench") == 0) {
+      benchFrames = BENCH_FRAMES;
+      if (i + 1 < argc && argv[i + 1][0] != '-') benchFrames = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "--soak") == 0 && i + 1 < argc) {
+      soak = true;
+      soakOptions.days = strtoul(argv[++i], nullptr, 10);
+    } else if (strcmp(argv[i], "--games") == 0 && i + 1 < argc) {
+      soakOptions.games = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+      soakOptions.seed = strtoul(argv[++i], nullptr, 10);
+    } else if (strcmp(argv[i], "--quiet") == 0) {
+      hostLogEnabled = false;
+    } else {
+      printf("Uso: %s [--frames N] [--out DIR] [--raw FICHERO] [--quiet] [--bench [FRAMES]]\n"
+             "       %s --soak DIAS [--games N] [--seed S]\n", argv[0], argv[0]);
+      return 1;
+    }
+  }
+  
+  if (soak) return runSoak(soakOptions);
+  
+  Wire.begin();
+  if (!display.begin(SSD1306_SWITCHCAPVCC, HOST_PANEL_ADDRESS)) {
+    log_e("SSD1306 allocation failed");
+    return 1;
+  }
+  pet.initialize();
+  displayMgr.initialize(&display, &pet, &eyesClock, &eyesRng);
+  Wire.resetStats();
+  
+  if (benchFrames > 0) {
+    // Los logs de los juegos ensuciarían la tabla
+    hostLogEnabled = false;
+    RenderBenchmark bench(&display, &displayMgr, &eyesClock);
+    bench.run(&Serial, benchFrames);
+    return 0;
+  }
+  
+  // Pantalla principal: ojos animados al ritmo de loop(), alargando el
+  // intervalo si el envío no cabe en el bus
+  unsigned long interval = FRAME_MS_EYES;
+  unsigned long eyesStart = eyesClock.now();
+  unsigned long eyesBus = Wire.getBusMicros();
+  unsigned long eyesSent = display.getFramesSent();
+  for (int i = 0; i < mainFrames; i++) {
+    eyesClock.advance(interval);
+    unsigned long busBefore = Wire.getBusMicros();
+    displayMgr.showMainScreen();
+    commit();
+    interval = pacedFrameInterval(FRAME_MS_EYES, Wire.getBusMicros() - busBefore);
+  }
+  unsigned long eyesMs = eyesClock.now() - eyesStart;
+  
+  // Menús y pantallas estáticas (la segunda pasada debe salir de la caché)
+  for (int pass = 0; pass < 2; pass++) {
+    for (int option = 0; option < 4; option++) {
+      displayMgr.showMenuScreen(option, true);
+      commit();
+    }
+    for (int option = 0; option < 5; option++) {
+      displayMgr.showShopMenuScreen(option);
+      commit();
+    }
+    for (int option = 0; option < 3; option++) {
+      displayMgr.showGameMenuScreen(option);
+      commit();
+    }
+    displayMgr.showSleepScreen();
+    commit();
+  }
+  
+  if (rawStream != nullptr) fclose(rawStream);
+  
+  printf("Frames grabados: %lu (incorrectos: %lu)\n", recordedFrames, mismatchedFrames);
+  printf("display(): %lu  Paginas: %lu  Bytes datos: %lu  Bytes cmd: %lu\n",
+         display.getFramesFlushed(), display.getPagesFlushed(),
+         display.getBytesSent(), display.getCommandBytesSent());
+  if (eyesMs > 0) {
+    printf("Ojos: %lu frames enviados en %lu ms (%.1f FPS)  bus ocupado %.1f%%\n",
+           display.getFramesSent() - eyesSent, eyesMs,
+           (display.getFramesSent() - eyesSent) * 1000.0 / eyesMs,
+           (Wire.getBusMicros() - eyesBus) / (eyesMs * 10.0));
+  }
+  printf("Bus I2C: %lu bytes en %lu transacciones (%lu us)\n",
+         Wire.getBytesWritten(), Wire.getTransactions(), Wire.getBusMicros());
+  
+  return mismatchedFrames == 0 ? 0 : 2;
+}
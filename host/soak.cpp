@@ -0,0 +1,270 @@
+/*
+ * Modo soak del host: la mascota y los juegos corren sobre un ManualClock y
+ * un SeededRng, así que una partida de minutos o un día entero se simulan sin
+ * esperar. Los jugadores son bots sencillos con algo de error, suficientes
+ * para balancear recompensas y detectar estados imposibles.
+ */
+
+#include "soak.h"
+#include <Preferences.h>
+#include "clock.h"
+#include "governor.h"
+#include "tamagotchi.h"
+#include "game.h"
+#include "tapgame.h"
+#include "memorygame.h"
+#include "tictactoe.h"
+
+#define SOAK_STEP_MS 1000            // Paso de la vida de la mascota
+#define SOAK_DECISION_MS 60000       // El cuidador actúa una vez por minuto
+#define SOAK_GAME_LIMIT_MS 600000UL  // Ninguna partida simulada pasa de 10 minutos
+#define SOAK_MEMORY_MAX_LEVEL 100
+#define SOAK_TAP_MS 30000            // Duración de cada partida de tocar objetivos
+#define SOAK_TAP_REACT_MIN_MS 250    // Reacción del bot de tocar: la más rápida...
+#define SOAK_TAP_REACT_MAX_MS 1200   // ...y la más lenta
+#define SOAK_TAP_MISS_PCT 15         // Toques que no aciertan al objetivo
+
+static ManualClock soakClock;
+static SeededRng soakRng;
+static unsigned long violations = 0;
+
+// Comprueba los invariantes de la mascota tras cada paso
+static void checkPet(Tamagotchi& pet) {
+  if (pet.getHunger() < 0 || pet.getHunger() > 100 ||
+      pet.getBoredom() < 0 || pet.getBoredom() > 100 ||
+      pet.getSleepiness() < 0 || pet.getSleepiness() > 100) {
+    violations++;
+  }
+}
+
+// ==================== BOTS ====================
+
+// Esquiva si hay una caja cerca en su carril y el otro está libre. Reacciona
+// en el 20% de los ticks, así que con las cajas rápidas a veces llega tarde
+static void dodgeBot(DodgeGame& game) {
+  const Obstacle* obstacles = game.getObstacles();
+  int lane = game.getPlayerLane();
+  int other = (lane == 1) ? 2 : 1;
+  bool threat = false;
+  bool otherBlocked = false;
+
+  for (int i = 0; i < MAX_OBSTACLES; i++) {
+    if (!obstacles[i].active) continue;
+    if (obstacles[i].x < 2 || obstacles[i].x > 30) continue;
+    if (obstacles[i].lane == lane) threat = true;
+    if (obstacles[i].lane == other) otherBlocked = true;
+  }
+
+  if (threat && !otherBlocked && soakRng.next(100) < 20) {
+    game.toggleLane();
+  }
+}
+
+// Partida completa de esquivar con el mismo tick fijo que main.cpp
+static int playDodge(DodgeGame& game) {
+  game.reset();
+  unsigned long start = soakClock.now();
+  while (soakClock.now() - start < SOAK_GAME_LIMIT_MS) {
+    soakClock.advance(FRAME_MS_DODGE);
+    dodgeBot(game);
+    game.update();
+    if (game.checkCollision()) break;
+  }
+  return game.getLevel();
+}
+
+// Juega al azar: el cursor avanza unas casillas y coloca ficha
+static GameResult playTicTacToe(TicTacToeGame& game) {
+  game.reset();
+  unsigned long start = soakClock.now();
+  while (game.getState() != TIC_GAME_OVER && soakClock.now() - start < SOAK_GAME_LIMIT_MS) {
+    if (game.getState() == TIC_PLAYER_TURN) {
+      int moves = soakRng.next(9);
+      for (int i = 0; i < moves; i++) game.moveCursor();
+      while (!game.tryPlacePiece()) game.moveCursor();
+    } else {
+      soakClock.advance(FRAME_MS_MENU);
+      game.update();
+    }
+  }
+  return game.getResult();
+}
+
+// Repite la secuencia con un 5% de error por símbolo
+static int playMemory(MemoryGame& game) {
+  game.reset();
+  while (game.getState() != MGS_GAME_OVER && game.getLevel() < SOAK_MEMORY_MAX_LEVEL) {
+    game.startShowingSequence();
+    soakClock.advance(1000UL * game.getSequenceLength());
+    game.startWaitingInput();
+
+    int level = game.getLevel();
+    const int* sequence = game.getSequence();
+    for (int i = 0; game.getLevel() == level && game.getState() != MGS_GAME_OVER; i++) {
+      int symbol = sequence[i];
+      if (soakRng.next(100) < 5) symbol = 1 - symbol;
+      unsigned long duration = (symbol == MORSE_DOT) ? 150 : 600;
+      game.registerButtonPress();
+      soakClock.advance(duration);
+      game.registerButtonRelease(duration);
+      soakClock.advance(200);
+    }
+  }
+  return game.getLevel();
+}
+
+static unsigned long tapReaction() {
+  return SOAK_TAP_REACT_MIN_MS + soakRng.next(SOAK_TAP_REACT_MAX_MS - SOAK_TAP_REACT_MIN_MS);
+}
+
+// Tarda en reaccionar a cada objetivo entre SOAK_TAP_REACT_MIN_MS y
+// SOAK_TAP_REACT_MAX_MS y falla el SOAK_TAP_MISS_PCT% de los toques (vuelve
+// a intentarlo tras otra reacción). Con los objetivos apareciendo cada 2 s a
+// 0,5 s, la puntuación depende de lo rápido que sea frente a ese ritmo
+static int playTap(TapGame& game) {
+  game.reset();
+  unsigned long start = soakClock.now();
+  unsigned long tapAt = 0;
+  bool aiming = false;
+  while (soakClock.now() - start < SOAK_TAP_MS) {
+    soakClock.advance(FRAME_MS_MENU);
+    game.update();
+    if (!game.isGameActive()) {
+      aiming = false;
+      continue;
+    }
+    if (!aiming) {
+      aiming = true;
+      tapAt = soakClock.now() + tapReaction();
+    }
+    if ((long)(soakClock.now() - tapAt) < 0) continue;
+    if (soakRng.next(100) < SOAK_TAP_MISS_PCT) {
+      tapAt = soakClock.now() + tapReaction();
+    } else {
+      game.registerTap();
+      aiming = false;
+    }
+  }
+  return game.getScore();
+}
+
+// ==================== VIDA DE LA MASCOTA ====================
+
+static void soakPet(unsigned long days, DodgeGame& game) {
+  Tamagotchi pet;
+  pet.initialize(&soakClock);
+
+  unsigned long feeds = 0, plays = 0, naps = 0, lowMinutes = 0, coinsEarned = 0;
+  int minCoins = pet.getCoins();
+  unsigned long start = soakClock.now();
+  unsigned long end = start + days * 86400000UL;
+  unsigned long nextDecision = start + SOAK_DECISION_MS;
+
+  while (soakClock.now() < end) {
+    soakClock.advance(SOAK_STEP_MS);
+    pet.update();
+    checkPet(pet);
+
+    if (soakClock.now() < nextDecision) continue;
+    nextDecision += SOAK_DECISION_MS;
+
+    if (pet.getHunger() <= 20 || pet.getBoredom() <= 20 || pet.getSleepiness() <= 20) lowMinutes++;
+    if (pet.getIsSleeping()) continue;
+
+    // Cuidador: duerme si tiene sueño, come si tiene hambre y juega si se aburre
+    if (pet.getSleepiness() <= 20) {
+      if (pet.sleep()) naps++;
+    } else if (pet.getHunger() < 40 && pet.getCoins() >= 10) {
+      if (pet.feed()) feeds++;
+    } else if (pet.getBoredom() < 40 || pet.getCoins() < 10) {
+      if (pet.play()) {
+        // Mismas monedas que endGame() en main.cpp
+        int level = playDodge(game);
+        int coins = (level * (level + 1)) / 2;
+        if (level > 1) coins += 2 * (level - 1);
+        pet.addCoins(coins);
+        pet.addBoredom(coins);
+        coinsEarned += coins;
+        plays++;
+        pet.update();
+        checkPet(pet);
+      }
+    }
+    if (pet.getCoins() < minCoins) minCoins = pet.getCoins();
+  }
+
+  printf("Mascota: %lu dias  comidas %lu  partidas %lu  siestas %lu  monedas ganadas %lu (minimo %d)\n",
+         days, feeds, plays, naps, coinsEarned, minCoins);
+  printf("  Minutos con alguna estadistica <= 20%%: %lu de %lu\n",
+         lowMinutes, (end - start) / SOAK_DECISION_MS);
+  printf("  Final: hambre %d  aburrimiento %d  sueno %d  monedas %d\n",
+         pet.getHunger(), pet.getBoredom(), pet.getSleepiness(), pet.getCoins());
+}
+
+// ==================== JUEGOS ====================
+
+static void soakGames(int games, DodgeGame& dodge) {
+  TapGame tap;
+  MemoryGame memory;
+  TicTacToeGame ticTacToe;
+  tap.initialize(&soakClock, &soakRng);
+  memory.initialize(&soakClock, &soakRng);
+  ticTacToe.initialize(&soakClock, &soakRng);
+
+  long dodgeLevels = 0, memoryLevels = 0, tapScores = 0;
+  int dodgeMax = 0, memoryMax = 0, tapMax = 0, tapMin = -1;
+  int wins = 0, draws = 0, losses = 0;
+
+  for (int i = 0; i < games; i++) {
+    int level = playDodge(dodge);
+    dodgeLevels += level;
+    if (level > dodgeMax) dodgeMax = level;
+
+    level = playMemory(memory);
+    memoryLevels += level;
+    if (level > memoryMax) memoryMax = level;
+
+    int score = playTap(tap);
+    tapScores += score;
+    if (score > tapMax) tapMax = score;
+    if (tapMin < 0 || score < tapMin) tapMin = score;
+
+    GameResult result = playTicTacToe(ticTacToe);
+    if (result == RESULT_PLAYER_WIN) wins++;
+    else if (result == RESULT_DRAW) draws++;
+    else if (result == RESULT_TAMAGOTCHI_WIN) losses++;
+    else violations++;  // Partida sin terminar
+  }
+
+  if (games <= 0) return;
+  printf("Esquivar: %d partidas  nivel medio %.2f  maximo %d\n",
+         games, (double)dodgeLevels / games, dodgeMax);
+  printf("Memoria: %d partidas  nivel medio %.2f  maximo %d\n",
+         games, (double)memoryLevels / games, memoryMax);
+  printf("Tocar: %d partidas  puntos medios %.1f  minimo %d  maximo %d\n",
+         games, (double)tapScores / games, tapMin, tapMax);
+  printf("Tres en raya: %d partidas  ganadas %d  empates %d  perdidas %d\n",
+         games, wins, draws, losses);
+}
+
+int runSoak(const SoakOptions& options) {
+  // Los juegos registran cada pulsación
+  hostLogEnabled = false;
+  Preferences::resetAll();
+  soakClock.set(0);
+  soakRng.seed(options.seed);
+  violations = 0;
+
+  DodgeGame dodge;
+  dodge.initialize(&soakClock, &soakRng);
+
+  unsigned long startMicros = micros();
+  if (options.days > 0) soakPet(options.days, dodge);
+  soakGames(options.games, dodge);
+  unsigned long elapsed = micros() - startMicros;
+
+  printf("Tiempo simulado: %.1f h en %.1f ms reales (semilla %lu)\n",
+         soakClock.now() / 3600000.0, elapsed / 1000.0, (unsigned long)options.seed);
+  printf("Incoherencias: %lu\n", violations);
+  return violations == 0 ? 0 : 2;
+}
@@ -0,0 +1,17 @@
+#ifndef HOST_SOAK_H
+#define HOST_SOAK_H
+
+#include <Arduino.h>
+
+// Simulación acelerada con reloj virtual: días de vida de la mascota y miles
+// de partidas en milisegundos. Con la misma semilla el resultado es idéntico.
+struct SoakOptions {
+  unsigned long days;  // Días simulados de vida de la mascota (0 = ninguno)
+  int games;           // Partidas simuladas de cada juego (0 = ninguna)
+  uint32_t seed;       // Semilla del generador
+};
+
+// Imprime el resumen y devuelve 0 si la simulación terminó sin incoherencias
+int runSoak(const SoakOptions& options);
+
+#endif
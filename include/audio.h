@@ -0,0 +1,87 @@
+#ifndef AUDIO_H
+#define AUDIO_H
+
+#include <Arduino.h>
+#ifdef ARDUINO_ARCH_ESP32
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#endif
+
+#define AUDIO_QUEUE_SIZE 16       // Notas en cola (la melodía más larga tiene 4)
+#define AUDIO_LEDC_CHANNEL 0      // Canal LEDC del buzzer (core 2.x)
+#define AUDIO_LEDC_RESOLUTION 8   // Bits de duty: basta para una onda cuadrada al 50%
+
+// Prioridad de un sonido: uno de prioridad mayor que todo lo que suena o
+// espera corta lo anterior; si no, se pone a la cola
+enum AudioPriority {
+  AUDIO_PRIORITY_ALERT,     // Avisos de estado bajo (hambre, aburrimiento, sueño)
+  AUDIO_PRIORITY_FEEDBACK,  // Pitidos de botones y de las secuencias de los juegos
+  AUDIO_PRIORITY_EVENT      // Caras, resultados de partidas y compras
+};
+
+struct AudioNote {
+  uint16_t frequency;  // Hz (0 = silencio)
+  uint16_t duration;   // ms sonando
+  uint16_t gap;        // ms de silencio antes de la nota siguiente
+};
+
+// Secuenciador del buzzer. play() solo copia las notas a una cola y vuelve
+// al momento; en el ESP32 las reproduce un esp_timer de un disparo que salta
+// en cada cambio de nota y escribe la frecuencia en el LEDC, así que loop()
+// nunca espera a que acabe una melodía. En otras placas (y en el host) se
+// avanza con update() desde loop() usando tone()/noTone().
+class AudioEngine {
+private:
+  enum Phase : uint8_t { AUDIO_IDLE, AUDIO_NOTE, AUDIO_GAP };
+
+  AudioNote queue[AUDIO_QUEUE_SIZE];
+  uint8_t priorities[AUDIO_QUEUE_SIZE];
+  uint8_t head;
+  uint8_t count;
+  AudioNote current;           // Nota que suena (o cuyo silencio transcurre)
+  uint8_t currentPriority;
+  volatile Phase phase;
+  volatile bool restart;       // La cola se ha sustituido: saltar a su primera nota
+  unsigned long stepAt;        // millis() del próximo cambio (solo con update())
+  uint8_t pin;
+  bool enabled;
+  bool started;
+
+  // Estadísticas
+  unsigned long notesPlayed;
+  unsigned long preemptions;   // Sonidos cortados por otro de más prioridad
+  unsigned long dropped;       // Sonidos descartados por no caber en la cola
+
+#ifdef ARDUINO_ARCH_ESP32
+  esp_timer_handle_t timer;
+  portMUX_TYPE lock;
+  static void timerEntry(void* arg);
+#endif
+
+  uint8_t highestPriority() const;  // De lo que suena y lo que espera
+  uint16_t step();  // Pasa a la fase siguiente; devuelve los ms que dura
+  void output(uint16_t frequency);
+  void kick();      // Arranca la reproducción tras cambiar la cola
+
+public:
+  AudioEngine();
+  bool begin(uint8_t buzzerPin);
+
+  // Encola las notas; false si el sonido está desactivado o no caben
+  bool play(const AudioNote* notes, uint8_t noteCount, AudioPriority priority);
+  bool playTone(uint16_t frequency, uint16_t duration, AudioPriority priority, uint16_t gap = 0);
+  void stop();  // Corta lo que suena y vacía la cola
+
+  void setEnabled(bool on);
+  bool isEnabled() const { return enabled; }
+  bool isPlaying();  // Suena algo o hay notas en cola (aún sin arrancar)
+
+  // Sin temporizador hardware avanza la cola; en el ESP32 no hace nada
+  void update(unsigned long now);
+
+  unsigned long getNotesPlayed() const { return notesPlayed; }
+  unsigned long getPreemptions() const { return preemptions; }
+  unsigned long getDropped() const { return dropped; }
+};
+
+#endif
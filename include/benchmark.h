@@ -0,0 +1,81 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <Arduino.h>
+#include "oled.h"
+#include "display.h"
+#include "game.h"
+#include "memorygame.h"
+#include "tictactoe.h"
+#include "clock.h"
+
+#define BENCH_FRAMES 100        // Frames medidos por pantalla
+#define BENCH_FRAME_PERIOD 10   // ms entre frames de pantallas animadas (RoboEyes a 120 FPS)
+
+// Micro-benchmark del render: pasa por todas las pantallas de DisplayManager
+// con un estado representativo y muestra por cada una el tiempo de render y
+// de envío por frame, los píxeles escritos, las primitivas GFX usadas y los
+// bytes enviados por I2C. Se compila con -DRENDER_BENCHMARK (env:bench en la
+// placa, env:native en el host).
+class RenderBenchmark {
+private:
+  OledDisplay* display;
+  DisplayManager* displayMgr;
+  ManualClock* clock;  // Reloj de los ojos si es manual (host); si no, se espera de verdad
+  
+  // Estado representativo de los juegos
+  DodgeGame dodge;
+  MemoryGame memory;
+  TicTacToeGame ticTacToe;
+  int option;  // Opción de menú que se recorre frame a frame
+  
+  typedef void (*RenderFn)(RenderBenchmark* bench);
+  
+  struct Scenario {
+    const char* name;
+    RenderFn setup;
+    RenderFn render;
+    bool animated;  // Necesita tiempo entre frames para que haya animación
+  };
+  
+public:
+  RenderBenchmark(OledDisplay* disp, DisplayManager* mgr, ManualClock* clk = nullptr);
+  
+  // Ejecuta todos los escenarios y escribe la tabla de resultados en out
+  void run(Print* out, int frames = BENCH_FRAMES);
+  
+private:
+  void runScenario(const Scenario& scenario, Print* out, int frames);
+  
+  void prepareDodge();
+  void prepareTicTacToe(GameResult result);
+  void settleEyes(int mood);
+  
+  static const Scenario scenarios[];
+  
+  // Escenarios: preparación opcional y dibujo de un frame
+  static void renderMain(RenderBenchmark* bench);
+  static void setupEyesDefault(RenderBenchmark* bench);
+  static void setupEyesTired(RenderBenchmark* bench);
+  static void setupEyesAngry(RenderBenchmark* bench);
+  static void setupEyesHappy(RenderBenchmark* bench);
+  static void renderEyesMood(RenderBenchmark* bench);
+  static void renderSleep(RenderBenchmark* bench);
+  static void renderInsufficientCoins(RenderBenchmark* bench);
+  static void renderMenu(RenderBenchmark* bench);
+  static void renderShopMenu(RenderBenchmark* bench);
+  static void renderGameMenu(RenderBenchmark* bench);
+  static void setupDodge(RenderBenchmark* bench);
+  static void renderDodge(RenderBenchmark* bench);
+  static void renderDodgeOver(RenderBenchmark* bench);
+  static void setupMemoryShowing(RenderBenchmark* bench);
+  static void setupMemoryInput(RenderBenchmark* bench);
+  static void renderMemory(RenderBenchmark* bench);
+  static void renderMemoryOver(RenderBenchmark* bench);
+  static void setupTicTacToe(RenderBenchmark* bench);
+  static void setupTicTacToeOver(RenderBenchmark* bench);
+  static void renderTicTacToe(RenderBenchmark* bench);
+  static void renderTicTacToeOver(RenderBenchmark* bench);
+};
+
+#endif
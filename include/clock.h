@@ -0,0 +1,59 @@
+#ifndef CLOCK_H
+#define CLOCK_H
+
+#include <Arduino.h>
+
+// Fuente de tiempo inyectable. En el firmware es millis(); en el host se
+// puede sustituir por un reloj manual para repetir animaciones frame a frame.
+class Clock {
+public:
+  virtual ~Clock() {}
+  virtual unsigned long now() = 0;  // Milisegundos
+};
+
+// Generador aleatorio inyectable
+class Rng {
+public:
+  virtual ~Rng() {}
+  virtual long next(long max) = 0;  // Entero en [0, max)
+  long next(long min, long max) { return min + next(max - min); }
+};
+
+// Implementaciones del dispositivo: millis() y random() de Arduino
+class SystemClock : public Clock {
+public:
+  unsigned long now() override { return millis(); }
+};
+
+class SystemRng : public Rng {
+public:
+  long next(long max) override { return max > 0 ? random(max) : 0; }
+};
+
+// Reloj que solo avanza cuando se le pide
+class ManualClock : public Clock {
+private:
+  unsigned long current;
+  
+public:
+  ManualClock(unsigned long start = 0) : current(start) {}
+  unsigned long now() override { return current; }
+  void advance(unsigned long ms) { current += ms; }
+  void set(unsigned long ms) { current = ms; }
+};
+
+// xorshift32 con semilla fija: la misma semilla repite la misma secuencia
+class SeededRng : public Rng {
+private:
+  uint32_t state;
+  
+public:
+  SeededRng(uint32_t seed = 1) : state(seed ? seed : 1) {}
+  long next(long max) override;
+  void seed(uint32_t s) { state = s ? s : 1; }
+};
+
+extern SystemClock systemClock;
+extern SystemRng systemRng;
+
+#endif
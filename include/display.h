@@ -2,23 +2,58 @@
 #define DISPLAY_H
 
 #include <Arduino.h>
-#include <Adafruit_SSD1306.h>
+#include "oled.h"
 #include "tamagotchi.h"
 #include "game.h"
 #include "memorygame.h"
 #include "tictactoe.h"
 #include "eyes.h"
+#include "textatlas.h"
+
+#define SLEEP_DIM_PANEL true  // Bajar el contraste del panel en la pantalla de sueño
+
+// Identificadores de pantallas estáticas (base de la clave de caché)
+enum ScreenId {
+  SCREEN_MAIN = 1,
+  SCREEN_SLEEP,
+  SCREEN_INSUFFICIENT_COINS,
+  SCREEN_MENU,
+  SCREEN_SHOP_MENU,
+  SCREEN_GAME_MENU,
+  SCREEN_EYE_POSE,
+  SCREEN_CAPTION
+};
+
+// Ojos simples del juego de memoria (eventos TL_EYE_POSE de Timeline)
+enum EyePose {
+  EYE_POSE_NORMAL,
+  EYE_POSE_BLINK,
+  EYE_POSE_LOOK_UP
+};
 
 class DisplayManager {
 private:
-  Adafruit_SSD1306* display;
+  OledDisplay* display;
   Tamagotchi* pet;
   EyesManager eyesManager;
+  TextAtlas textAtlas;
   int currentMood;
+  bool frameDirty;  // Algo se dibujó en el buffer desde el último envío
+  uint32_t renderedScreenKey;  // Clave del estado de la pantalla estática en el buffer (0 = ninguna)
+  bool sleepFrame;    // El frame actual es la pantalla de sueño
+  bool panelDimmed;   // Contraste del panel reducido
+  unsigned long deferredFrames;  // Frames que esperaron al tick siguiente por el bus ocupado
   
 public:
   DisplayManager();
-  void initialize(Adafruit_SSD1306* disp, Tamagotchi* p);
+  // clock y rng mueven la animación de los ojos (inyectables para repetirla en el host)
+  void initialize(OledDisplay* disp, Tamagotchi* p, Clock* clock = &systemClock, Rng* rng = &systemRng);
+  
+  // Los métodos show* solo dibujan en el buffer; commitFrame() lo envía
+  // al panel una única vez al final de cada iteración de loop()
+  void commitFrame();
+  unsigned long getDeferredFrames() const { return deferredFrames; }
+  void invalidateScreenCache();  // Fuerza a rasterizar de nuevo la próxima pantalla estática
   
   void showMainScreen();
   void showSleepScreen();
@@ -37,9 +72,23 @@ public:
   void showEyesBlink();    // Mostrar parpadeo
   void showEyesLookUp();   // Mostrar mirando arriba
   void showEyesNormal();   // Volver a normal
+  void showEyesPose(int pose);  // EyePose
+  
+  // Vistas de las secuencias de Timeline
+  void showEyesMood(int mood);        // Ojos animados con un mood fijo
+  void showCaption(TextLabel label);  // Etiqueta centrada a pantalla completa
   
 private:
-  void drawEyesAnimated();
+  // Caché de pantallas estáticas: si la clave coincide con la del buffer
+  // no se vuelve a rasterizar ni a enviar
+  static uint32_t mixKey(uint32_t key, int32_t value);
+  bool isScreenCached(uint32_t key);
+  
+  // Texto fijo desde el atlas pre-rasterizado
+  void drawLabel(TextLabel label, int16_t x, int16_t y, uint16_t color = SSD1306_WHITE);
+  void drawLabelValue(TextLabel label, int16_t x, int16_t y, int value);
+  
+  void drawEyesAnimated(bool bufferLost);
   void drawStatusBar();
   void drawMenu(int selectedOption);
   void drawGameMenu(int selectedOption);
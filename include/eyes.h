@@ -2,38 +2,109 @@
 #define EYES_H
 
 #include <Arduino.h>
-#include <Adafruit_SSD1306.h>
+#include "oled.h"
+#include "pagecanvas.h"
+#include "spritecache.h"
+#include "clock.h"
+#include "eyetween.h"
 #include <RoboEyesWrapper.h>
 
+// Ritmo de las animaciones de los ojos (ms)
+#define EYE_BLINK_INTERVAL_MS 5000   // Parpadeo cada 5-7 segundos
+#define EYE_BLINK_VARIATION_MS 2000
+#define EYE_BLINK_MS 250             // Cerrar y reabrir los ojos
+#define EYE_GAZE_INTERVAL_MS 10000   // Mirada a un punto al azar cada 10-15 segundos
+#define EYE_GAZE_VARIATION_MS 5000
+#define EYE_GAZE_MOVE_MS 300         // Transición al nuevo punto de mirada
+#define EYE_MOOD_BLEND_MS 400        // Transición entre dos moods
+#define EYE_CURIOUS_OFFSET 8         // Ojo más alto al mirar a un lado (como RoboEyes)
+
+// Valores de un mood: párpados en 1/256 del alto del ojo, apertura (256 =
+// abiertos) y cuánto crece el ojo que mira a un lado (256 = modo curioso)
+enum EyeMoodValue {
+  EYE_MOOD_TIRED,
+  EYE_MOOD_SLEEPY,
+  EYE_MOOD_ANGRY,
+  EYE_MOOD_HAPPY,
+  EYE_MOOD_OPEN,
+  EYE_MOOD_CURIOUS,
+  EYE_MOOD_VALUES
+};
+
+// Valores de la mirada: posición del ojo izquierdo y alto extra de cada ojo
+enum EyeGazeValue {
+  EYE_GAZE_X,
+  EYE_GAZE_Y,
+  EYE_GAZE_OFFSET_L,
+  EYE_GAZE_OFFSET_R,
+  EYE_GAZE_VALUES
+};
+
+// Estados de la animación
+enum EyeAnimState {
+  EYE_ANIM_IDLE,      // Ojos abiertos esperando el próximo parpadeo o cambio de mirada
+  EYE_ANIM_BLINKING,  // Parpadeo en curso: no se mueve la mirada
+  EYE_ANIM_CLOSED     // Mood con los ojos cerrados: sin parpadeos ni miradas
+};
+
+// Ojos de la pantalla principal. Una única máquina de estados decide
+// parpadeos, mood y mirada con el reloj y el generador inyectados, así que
+// con ManualClock y SeededRng la animación se repite igual frame a frame.
+// El autoblinker y el modo idle de RoboEyes quedan desactivados.
+//
+// Las transiciones (mood, mirada, parpadeo) son por tiempo con EyeTween: no
+// dependen de cuántos frames dibuje loop() y siempre terminan en el mismo
+// punto. RoboEyes solo dibuja los valores que se le dan (setExternalTweening).
 class EyesManager {
 private:
-  Adafruit_SSD1306* display;
-  RoboEyes<Adafruit_SSD1306>* eyes;
+  OledDisplay* display;
+  RoboEyes<PageCanvas>* eyes;
+  Clock* clock;
+  Rng* rng;
   
-  unsigned long lastBlinkTime;
-  unsigned long blinkInterval;
-  bool isBlinking;
+  // RoboEyes dibuja en un lienzo que cubre solo la caja de los ojos
+  // (alineada a páginas) y se copia al frame
+  uint8_t canvasBuffer[OLED_WIDTH * OLED_PAGES];
+  PageCanvas canvas;
+  EyelidCache eyelidCache;  // Párpados de los moods cansado y enfadado
+  int16_t drawnX;      // Columnas y páginas del frame que ocupan los ojos
+  int16_t drawnW;
+  int16_t drawnPage;
+  int16_t drawnPages;
+  
+  // Máquina de estados
+  EyeAnimState state;
+  unsigned long nextBlinkAt;  // Próximo parpadeo (o fin del parpadeo en curso)
+  unsigned long nextGazeAt;   // Próximo cambio de mirada
+  unsigned long blinkStartAt;
   int mood; // 0=normal, 1=tired, 2=angry, 3=happy, 4=sleepy, 5=sad
+  EyeTween moodTween;
+  EyeTween gazeTween;
+  
+  // Estadísticas
+  unsigned long blinks;
+  unsigned long gazes;
   
 public:
   EyesManager();
-  void initialize(Adafruit_SSD1306* disp);
+  void initialize(OledDisplay* disp, Clock* clk = &systemClock, Rng* rnd = &systemRng);
   
-  void update();
-  void drawEyesAnimated();
+  bool drawEyesAnimated(bool bufferLost = false);  // true si se dibujó un frame nuevo
+  bool isAtRest();                  // Los ojos no cambiarán hasta getNextChangeAt()
+  unsigned long getNextChangeAt();  // Próximo parpadeo o cambio de mirada
   void setMood(int newMood);
   
-  void setHappy();
-  void setSad();
-  void setNormal();
-  void setSleep();
-  void setBlink();
-  void setAwake();
-  void lookUp();
-  void lookCenter();
+  unsigned long getBlinks() const { return blinks; }
+  unsigned long getGazes() const { return gazes; }
   
 private:
-  void drawEyes();
+  void animate(unsigned long now);
+  void scheduleBlink(unsigned long now);
+  void scheduleGaze(unsigned long now);
+  void startGaze(int16_t x, int16_t y, unsigned long now, uint16_t ms);
+  void applyTweens(unsigned long now);
+  int16_t getBlinkOpenness(unsigned long now);
+  void composite(int16_t x, int16_t page, int16_t w, int16_t pages);
 };
 
 #endif
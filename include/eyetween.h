@@ -0,0 +1,38 @@
+#ifndef EYETWEEN_H
+#define EYETWEEN_H
+
+#include <Arduino.h>
+
+#define EYE_EASE_STEPS 64    // Pasos de la tabla de la curva
+#define EYE_TWEEN_VALUES 6   // Valores que puede interpolar un EyeTween
+
+// Curva ease-in-out (smoothstep) de 0 a 255 para t = elapsed / duration,
+// leída de una tabla en flash
+uint8_t eyeEase(unsigned long elapsed, unsigned long duration);
+
+// Interpola por tiempo hasta EYE_TWEEN_VALUES valores entre el punto en que
+// se encontraban y un destino. El resultado solo depende del tiempo
+// transcurrido: da igual cuántos frames se dibujen entre medias, y cada
+// muestra es una búsqueda en la tabla y un producto por valor.
+class EyeTween {
+private:
+  int16_t from[EYE_TWEEN_VALUES];
+  int16_t to[EYE_TWEEN_VALUES];
+  uint8_t count;
+  unsigned long startAt;
+  uint16_t duration;
+
+public:
+  EyeTween(uint8_t values);
+
+  // Fija los valores sin transición
+  void jump(const int16_t* values);
+  // Empieza a ir hacia target desde el valor actual (aunque haya otra transición a medias)
+  void start(const int16_t* target, unsigned long now, uint16_t ms);
+
+  void sample(unsigned long now, int16_t* out) const;
+  bool isActive(unsigned long now) const { return (now - startAt) < duration; }
+  unsigned long getEndAt() const { return startAt + duration; }
+};
+
+#endif
@@ -2,6 +2,7 @@
 #define GAME_H
 
 #include <Arduino.h>
+#include "clock.h"
 
 #define GAME_WIDTH 128
 #define GAME_HEIGHT 64
@@ -16,6 +17,8 @@ struct Obstacle {
 };
 
 class DodgeGame {
+  friend class RenderBenchmark;  // Prepara estados representativos para medir el render
+  
 private:
   int playerLane;
   int score;
@@ -30,9 +33,12 @@ private:
   int obstacleCount;
   int maxActiveObstacles; // Número máximo de cajas activas según nivel
   
+  Clock* clock;
+  Rng* rng;
+  
 public:
   DodgeGame();
-  void initialize();
+  void initialize(Clock* clk = &systemClock, Rng* rnd = &systemRng);
   void reset();
   void update();
   void loadRecord();
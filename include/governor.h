@@ -0,0 +1,58 @@
+#ifndef GOVERNOR_H
+#define GOVERNOR_H
+
+#include <Arduino.h>
+
+// Intervalo de frame por escena (ms)
+#define FRAME_MS_EYES 25    // Ojos animados: 40 FPS, lo que el bus I2C puede sostener
+#define FRAME_MS_DODGE 30   // Juego de esquivar: un tick de juego por frame
+#define FRAME_MS_MENU 20    // Menús: solo se envía si cambian; el intervalo marca el sondeo del botón
+#define FRAME_MS_MAX 100    // Tope con el bus saturado: el botón se sigue sondeando a 10 Hz
+#define FRAME_BUS_MARGIN_MS 2  // Margen sobre el envío estimado para dibujar el frame
+
+// Intervalo de una escena animada: el de la escena o, si el envío del frame
+// por I2C tarda más, el tiempo de envío medido más un margen. Pedir más
+// frames de los que el bus puede transmitir solo acumula esperas y plazos
+// perdidos; las animaciones no se ralentizan porque avanzan por tiempo.
+unsigned long pacedFrameInterval(unsigned long sceneMs, unsigned long flushMicros);
+
+// Regulador de frames para loop(): cada iteración tiene un presupuesto de
+// tiempo según la escena. Si el frame termina antes, el resto se cede a
+// FreeRTOS (delay) en lugar de girar en vacío; si termina tarde se cuenta
+// como plazo perdido y se descarta el envío del frame siguiente para
+// recuperar el ritmo.
+class FrameGovernor {
+private:
+  unsigned long interval;     // Presupuesto del frame actual (ms)
+  unsigned long frameStart;   // millis() al empezar el frame
+  unsigned long deadline;     // millis() en el que debe acabar el frame
+  unsigned long busyStart;    // micros() al empezar el frame
+  bool behind;                // El frame anterior se pasó de su plazo
+  bool skippedLast;           // El frame anterior no se envió
+  
+  // Estadísticas
+  unsigned long frames;
+  unsigned long skippedFrames;
+  unsigned long missedDeadlines;
+  unsigned long busyMicros;   // Tiempo trabajando (sin contar la espera)
+  unsigned long totalMicros;  // Tiempo total de los frames
+  
+public:
+  FrameGovernor();
+  
+  void beginFrame();
+  void setInterval(unsigned long ms);  // Presupuesto de la escena actual
+  // false si hay que descartar el envío de este frame (nunca dos seguidos)
+  bool shouldPresent();
+  void endFrame();  // Espera el resto del presupuesto
+  void resync();    // Tras una pausa intencionada (light sleep) sin contar plazo perdido
+  
+  unsigned long getInterval() const { return interval; }
+  unsigned long getFrames() const { return frames; }
+  unsigned long getSkippedFrames() const { return skippedFrames; }
+  unsigned long getMissedDeadlines() const { return missedDeadlines; }
+  unsigned long getLoadPercent() const;  // Porcentaje del tiempo ocupado trabajando
+  void resetStats();
+};
+
+#endif
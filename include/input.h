@@ -0,0 +1,105 @@
+#ifndef INPUT_H
+#define INPUT_H
+
+#include <Arduino.h>
+
+#ifndef ARDUINO_ISR_ATTR
+#define ARDUINO_ISR_ATTR
+#endif
+
+#define BUTTON_RING_SIZE 32      // Flancos en cola (potencia de 2); los rebotes también ocupan
+#define BUTTON_DEBOUNCE_MS 25    // Cambios más rápidos que esto son rebotes
+#define BUTTON_LONG_MS 500       // Al soltar: a partir de aquí es pulsación larga
+#define BUTTON_HOLD_MS 1000      // Sin soltar: a partir de aquí se emite Hold
+#define BUTTON_DOUBLE_MS 350     // Máximo entre dos pulsaciones cortas para DoublePress
+
+struct ButtonEdge {
+  unsigned long at;  // millis() del flanco
+  bool pressed;
+};
+
+// Captura del botón por interrupción. La ISR lee el nivel en cada flanco y,
+// si cambió, lo apunta con su hora en un anillo de un solo productor (la
+// ISR) y un solo consumidor (loop()), sin bloqueos: aunque loop() esté
+// ocupado enviando un frame, las pulsaciones quedan en cola con la hora
+// real. head y tail se publican con __atomic release/acquire, así que el
+// flanco siempre está escrito antes de verse en la cola. Sin interrupciones
+// (host) poll() muestrea el pin desde loop().
+class ButtonInput {
+private:
+  ButtonEdge ring[BUTTON_RING_SIZE];
+  uint8_t head;                 // Siguiente hueco (lo publica la ISR con release)
+  uint8_t tail;                 // Siguiente flanco por leer (lo libera loop() con release)
+  volatile bool rawPressed;     // Último nivel leído del pin
+  volatile unsigned long rawAt; // Cuándo cambió
+  volatile unsigned long overflows;
+  uint8_t pin;
+  bool attached;
+
+  void capture(unsigned long now);
+#ifdef ARDUINO_ARCH_ESP32
+  static void ARDUINO_ISR_ATTR isrEntry(void* arg);
+#endif
+
+public:
+  ButtonInput();
+  void begin(uint8_t buttonPin);
+
+  // Alrededor del light sleep: el despertar por GPIO reprograma la
+  // interrupción del pin. resume() apunta el nivel si cambió mientras tanto
+  void suspend();
+  void resume();
+
+  void poll(unsigned long now);  // Solo sin interrupciones
+  bool pop(ButtonEdge& out);
+
+  bool isPressed() const { return rawPressed; }
+  unsigned long getLastChangeAt() const { return rawAt; }
+  unsigned long getOverflows() const { return overflows; }
+};
+
+enum ButtonEventType {
+  BUTTON_DOWN,          // Se pulsa
+  BUTTON_UP,            // Se suelta (duration = tiempo pulsado)
+  BUTTON_SHORT_PRESS,   // Tras BUTTON_UP si duró menos de BUTTON_LONG_MS
+  BUTTON_LONG_PRESS,    // Tras BUTTON_UP si duró BUTTON_LONG_MS o más
+  BUTTON_DOUBLE_PRESS,  // Además de la segunda de dos cortas seguidas
+  BUTTON_HOLD           // Sigue pulsado tras BUTTON_HOLD_MS (una vez por pulsación)
+};
+
+struct ButtonEvent {
+  uint8_t type;            // ButtonEventType
+  unsigned long at;        // millis() del flanco que lo produjo
+  unsigned long duration;  // Tiempo pulsado (UP, SHORT, LONG, DOUBLE, HOLD)
+};
+
+// Único decodificador de gestos: convierte los flancos en eventos para la
+// escena activa. Filtra los rebotes (cambios a menos de BUTTON_DEBOUNCE_MS
+// del anterior) sin esperar y, si la cola se desbordó o el último cambio
+// fue descartado como rebote, se resincroniza con el nivel real del pin.
+// ShortPress se emite al soltar, sin esperar a ver si llega una segunda.
+class GestureDecoder {
+private:
+  ButtonInput* button;
+  ButtonEvent pending[3];  // Un flanco produce como mucho UP, SHORT y DOUBLE
+  uint8_t pendingCount;
+  uint8_t pendingNext;
+  bool down;
+  unsigned long changedAt;  // Último cambio aceptado
+  unsigned long downAt;
+  bool holdSent;
+  bool lastWasShort;
+  unsigned long lastShortAt;
+
+  void accept(bool pressed, unsigned long at, bool force);
+  void emit(ButtonEventType type, unsigned long at, unsigned long duration);
+
+public:
+  GestureDecoder();
+  void begin(ButtonInput* input);
+
+  // Entrega de uno en uno los eventos pendientes; false cuando no quedan
+  bool next(unsigned long now, ButtonEvent& out);
+};
+
+#endif
@@ -2,6 +2,7 @@
 #define MEMORYGAME_H
 
 #include <Arduino.h>
+#include "clock.h"
 
 #define MAX_SEQUENCE 20
 
@@ -32,9 +33,12 @@ private:
   unsigned long buttonPressStartTime;  // Para medir duración de pulsación
   bool buttonWasPressed;
   
+  Clock* clock;
+  Rng* rng;
+  
 public:
   MemoryGame();
-  void initialize();
+  void initialize(Clock* clk = &systemClock, Rng* rnd = &systemRng);
   void reset();
   void update();
   
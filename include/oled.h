@@ -0,0 +1,141 @@
+#ifndef OLED_H
+#define OLED_H
+
+#include <Arduino.h>
+#include <Wire.h>
+#include <Adafruit_SSD1306.h>
+#include "pagespan.h"
+#include "spritecache.h"
+#ifdef ARDUINO_ARCH_ESP32
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/semphr.h>
+#endif
+
+#define OLED_WIDTH 128
+#define OLED_HEIGHT 64
+#define OLED_PAGES (OLED_HEIGHT / 8)   // El SSD1306 agrupa la RAM en páginas de 8 filas
+#define OLED_WIRE_CHUNK 64             // Bytes de datos por transacción I2C (cabe en el buffer de Wire)
+#define OLED_FLUSH_STACK 3072          // Pila de la tarea de envío asíncrono (bytes)
+
+// Contadores de dibujo. Solo se actualizan al compilar con -DRENDER_BENCHMARK;
+// en el firmware normal RENDER_COUNT no genera código.
+struct RenderStats {
+  unsigned long pixels;      // Píxeles escritos en el buffer (por cualquier camino)
+  unsigned long pixelCalls;  // drawPixel
+  unsigned long hLines;      // drawFastHLine
+  unsigned long vLines;      // drawFastVLine
+  unsigned long rects;       // fillRect
+  unsigned long lines;       // drawLine
+  unsigned long roundRects;  // fillRoundRect
+  unsigned long triangles;   // fillTriangle
+  unsigned long chars;       // Caracteres de texto GFX
+  unsigned long blits;       // Etiquetas copiadas desde el atlas de texto
+  unsigned long clears;      // clearDisplay
+};
+
+#ifdef RENDER_BENCHMARK
+#define RENDER_COUNT(disp, field, n) ((disp)->getRenderStats().field += (n))
+#else
+#define RENDER_COUNT(disp, field, n) ((void)0)
+#endif
+
+// Display SSD1306 con seguimiento de páginas modificadas.
+// display() compara el buffer con el último frame enviado y solo transmite
+// por I2C la ventana de columnas que ha cambiado en cada página de 8 filas.
+//
+// Con beginAsync() el envío es doble buffer: display() copia el frame a un
+// buffer frontal y una tarea en segundo plano lo transmite mientras loop()
+// dibuja el siguiente frame en el buffer trasero de Adafruit.
+//
+// Cada envío se cronometra: getFlushEstimate() da lo que tarda en salir un
+// frame por el bus, para que FrameGovernor no pida más frames de los que
+// caben (pacedFrameInterval).
+class OledDisplay : public Adafruit_SSD1306 {
+private:
+  uint8_t sentBuffer[OLED_WIDTH * OLED_PAGES];  // Copia de lo que tiene la GDDRAM del panel
+  uint8_t frontBuffer[OLED_WIDTH * OLED_PAGES]; // Frame que está transmitiendo la tarea de envío
+  volatile bool fullRefreshPending;             // Forzar envío completo (tras begin o invalidate)
+#ifdef ARDUINO_ARCH_ESP32
+  TaskHandle_t flushTask;       // Tarea que transmite frontBuffer
+  SemaphoreHandle_t flushIdle;  // Disponible cuando no hay ningún envío en curso
+#endif
+  
+  // Contadores de tráfico I2C
+  unsigned long framesFlushed;     // Llamadas a display()
+  unsigned long pagesFlushed;      // Páginas transmitidas
+  unsigned long bytesSent;         // Bytes de píxeles transmitidos
+  unsigned long commandBytesSent;  // Bytes de comandos de direccionamiento
+  unsigned long flushWaits;        // Veces que display() esperó a que terminara el frame anterior
+  unsigned long framesSent;        // Envíos que transmitieron alguna página
+  unsigned long busMicros;         // Tiempo total ocupando el bus
+  volatile unsigned long flushEstimate;  // Duración estimada del envío de un frame (us)
+  
+  RenderStats renderStats;
+  RoundRectCache roundRectCache;  // Máscaras de los ojos ya rasterizadas
+  
+public:
+  OledDisplay(TwoWire* twi = &Wire);
+  bool begin(uint8_t switchvcc, uint8_t i2caddr);
+  
+  // Oculta Adafruit_SSD1306::display(): envía solo las páginas modificadas
+  void display();
+  void invalidate();  // El próximo display() reenvía la pantalla completa
+  void dim(bool dim);  // Contraste mínimo o normal (espera a que termine el envío en curso)
+  
+  // Envío asíncrono con doble buffer (solo ESP32; en otro caso display() es síncrono)
+  bool beginAsync(uint8_t priority = 2);
+  bool isAsync() const;
+  void waitForFlush();  // Bloquea hasta que el panel tenga el último frame
+  bool isFlushing();    // Hay un envío en curso (display() tendría que esperar)
+  
+  // Estadísticas
+  unsigned long getFramesFlushed() const { return framesFlushed; }
+  unsigned long getPagesFlushed() const { return pagesFlushed; }
+  unsigned long getBytesSent() const { return bytesSent; }
+  unsigned long getCommandBytesSent() const { return commandBytesSent; }
+  unsigned long getFlushWaits() const { return flushWaits; }
+  unsigned long getFramesSent() const { return framesSent; }
+  unsigned long getBusMicros() const { return busMicros; }
+  unsigned long getFlushEstimate() const { return flushEstimate; }
+  void resetStats();
+  
+  RenderStats& getRenderStats() { return renderStats; }
+  void resetRenderStats();
+  
+  // Rellenos por spans de página (pagespan.h) en lugar de columna a columna.
+  // fillScreen, los círculos y las cajas de los menús llegan aquí a través
+  // de writeFillRect/fillRect. Con rotación distinta de 0 se usa Adafruit.
+  void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) override;
+  void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) override;
+  void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) override;
+  
+  // Oculta Adafruit_GFX::fillRoundRect (no es virtual; funciona cuando se
+  // llama con el tipo OledDisplay): copia la máscara cacheada en lugar de
+  // recalcular las esquinas en cada frame. El lienzo de los ojos comparte
+  // la caché a través de getRoundRectCache().
+  void fillRoundRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t r, uint16_t color);
+  RoundRectCache& getRoundRectCache() { return roundRectCache; }
+  
+#ifdef RENDER_BENCHMARK
+  // Envoltorios que cuentan las primitivas antes de delegar en Adafruit.
+  // Los no virtuales (clearDisplay, fillTriangle) solo se
+  // cuentan cuando se llaman con el tipo OledDisplay, que es como lo hace
+  // DisplayManager. Lo que RoboEyes dibuja en su lienzo cuenta como un blit.
+  void drawPixel(int16_t x, int16_t y, uint16_t color) override;
+  void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) override;
+  size_t write(uint8_t c) override;
+  using Adafruit_SSD1306::write;
+  void clearDisplay();
+  void fillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint16_t color);
+#endif
+  
+private:
+  void transmit(const uint8_t* frame);
+#ifdef ARDUINO_ARCH_ESP32
+  static void flushTaskEntry(void* arg);
+#endif
+  void sendWindow(uint8_t page, uint8_t colStart, uint8_t colEnd, const uint8_t* data);
+};
+
+#endif
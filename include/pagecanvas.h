@@ -0,0 +1,57 @@
+#ifndef PAGECANVAS_H
+#define PAGECANVAS_H
+
+#include <Arduino.h>
+#include <Adafruit_GFX.h>
+#include "pagespan.h"
+
+class RoundRectCache;
+class EyelidCache;
+
+// Lienzo GFX fuera de pantalla con el mismo formato de páginas que la RAM
+// del SSD1306, de modo que lo dibujado se copia al display con pageBlit().
+// No reserva memoria: dibuja sobre el buffer que se le pasa, de
+// ((h + 7) / 8) * w bytes.
+//
+// setWindow() lo coloca sobre una ventana de la pantalla: se dibuja con
+// coordenadas de pantalla y el lienzo solo guarda la parte de la ventana.
+class PageCanvas : public Adafruit_GFX {
+private:
+  uint8_t* bitmap;
+  int16_t canvasW;    // Tamaño actual (WIDTH/HEIGHT de GFX son los del constructor)
+  int16_t canvasH;
+  int16_t originX;
+  int16_t originY;
+  RoundRectCache* roundRects;  // Opcional: fillRoundRect desde máscaras cacheadas
+  EyelidCache* eyelids;        // Opcional: párpados de RoboEyes por columnas
+  
+public:
+  PageCanvas(uint8_t* bmp, int16_t w, int16_t h)
+    : Adafruit_GFX(w, h), bitmap(bmp), canvasW(w), canvasH(h),
+      originX(0), originY(0), roundRects(nullptr), eyelids(nullptr) {}
+  
+  uint8_t* getBuffer() const { return bitmap; }
+  int16_t getPages() const { return (canvasH + 7) / 8; }
+  int16_t getOriginX() const { return originX; }
+  int16_t getOriginY() const { return originY; }
+  
+  // Mueve y redimensiona el lienzo; el buffer debe tener sitio para w x h
+  void setWindow(int16_t x, int16_t y, int16_t w, int16_t h);
+  void setRoundRectCache(RoundRectCache* cache) { roundRects = cache; }
+  void setEyelidCache(EyelidCache* cache) { eyelids = cache; }
+  
+  void drawPixel(int16_t x, int16_t y, uint16_t color) override;
+  void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) override;
+  void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) override;
+  void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) override;
+  void fillScreen(uint16_t color) override;
+  
+  // Oculta Adafruit_GFX::fillRoundRect para usar la caché si la hay
+  void fillRoundRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t r, uint16_t color);
+  // Oculta Adafruit_GFX::fillTriangle: los párpados (lado horizontal arriba
+  // y un lado vertical) se rellenan por columnas desde la caché
+  void fillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                    int16_t x2, int16_t y2, uint16_t color);
+};
+
+#endif
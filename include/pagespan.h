@@ -0,0 +1,34 @@
+#ifndef PAGESPAN_H
+#define PAGESPAN_H
+
+#include <Arduino.h>
+#include <Adafruit_SSD1306.h>
+
+// Kernels de relleno para buffers en formato página del SSD1306: cada byte
+// guarda 8 filas de una columna, así que una fila de píxeles es un bit en
+// bytes consecutivos y un bloque de 8 filas alineado es un memset.
+//
+// Escriben bytes completos y palabras de 32 bits en lugar de píxel a píxel
+// o columna a columna como Adafruit_GFX.
+
+// Aplica mask (bits de fila dentro de la página) a n bytes consecutivos
+void pageFillSpan(uint8_t* dst, int16_t n, uint8_t mask, uint16_t color);
+
+// Rellena un rectángulo con recorte sobre un buffer de width x height píxeles
+void pageFillRect(uint8_t* buf, int16_t width, int16_t height,
+                  int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+
+// Copia una máscara en formato página (w columnas x pages páginas) en (x, y)
+// con recorte. Los bits a 1 se pintan con color (WHITE = OR, BLACK = borrar,
+// INVERSE = XOR); los bits a 0 no tocan el destino.
+void pageBlit(uint8_t* buf, int16_t width, int16_t height,
+              const uint8_t* src, int16_t w, int16_t pages,
+              int16_t x, int16_t y, uint16_t color);
+
+// Rellena n columnas consecutivas desde (x, y) hacia abajo, cada una con
+// heights[c] filas, con recorte. Cada página de una columna es un solo byte.
+void pageFillColumns(uint8_t* buf, int16_t width, int16_t height,
+                     int16_t x, int16_t y, const uint8_t* heights, int16_t n,
+                     uint16_t color);
+
+#endif
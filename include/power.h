@@ -0,0 +1,39 @@
+#ifndef POWER_H
+#define POWER_H
+
+#include <Arduino.h>
+
+#define LIGHT_SLEEP_MIN_MS 20  // Por debajo de esto no compensa entrar en light sleep
+
+// Resultado de lightSleep()
+enum SleepResult {
+  SLEEP_SKIPPED,  // No durmió: intervalo muy corto o botón pulsado
+  SLEEP_TIMER,    // Durmió hasta el final del intervalo
+  SLEEP_BUTTON    // Lo despertó el botón
+};
+
+// Ahorro de energía mientras el Tamagotchi duerme: light sleep del ESP32-C3
+// con despertar por temporizador o por el botón (nivel bajo en el pin).
+// La RAM, los periféricos y millis() se conservan; el panel sigue mostrando
+// lo último que recibió porque tiene su propia GDDRAM.
+class PowerManager {
+private:
+  uint8_t wakePin;
+  unsigned long sleepCount;   // Veces que se entró en light sleep
+  unsigned long sleptMillis;  // Tiempo total dormido
+  
+public:
+  PowerManager();
+  void initialize(uint8_t pin);
+  
+  // Duerme la CPU hasta ms milisegundos. No duerme si el botón ya está
+  // pulsado o si el intervalo es muy corto: entonces devuelve SLEEP_SKIPPED
+  // y quien llama tiene que ceder la CPU por su cuenta.
+  SleepResult lightSleep(unsigned long ms);
+  bool canSleep(unsigned long ms) const;  // lightSleep(ms) llegaría a dormir
+  
+  unsigned long getSleepCount() const { return sleepCount; }
+  unsigned long getSleptMillis() const { return sleptMillis; }
+};
+
+#endif
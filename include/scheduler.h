@@ -0,0 +1,130 @@
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <Arduino.h>
+#include "input.h"
+
+#define SCHEDULER_MAX_TASKS 6   // Tareas de fondo registrables
+
+// Pantalla del firmware (ojos, menús, tienda, cada juego...). El scheduler
+// solo ejecuta la escena activa: input() recibe los eventos del botón,
+// update() avanza la lógica y render() dibuja en el buffer; enter()/exit()
+// al entrar y salir; resume() cuando vuelve a ser la activa tras una
+// interrupción (otra escena ha dibujado en el buffer mientras tanto).
+// Cada escena lleva la cuenta de lo que cuesta su tick. El tiempo lo da el
+// planificador (now, y event.at en input(), nunca posterior a now): las
+// escenas no leen millis() por su cuenta.
+class Scene {
+private:
+  const char* name;
+  unsigned long ticks;
+  unsigned long totalMicros;
+  unsigned long maxMicros;
+  unsigned long overruns;  // Ticks que no cupieron en frameInterval()
+
+public:
+  Scene(const char* name);
+  virtual ~Scene() {}
+
+  virtual void enter(unsigned long now) {}
+  virtual void resume(unsigned long now) {}
+  virtual void input(const ButtonEvent& event) {}
+  virtual void update(unsigned long now) {}
+  virtual void render() = 0;
+  virtual void exit() {}
+  // Presupuesto de frame de la escena (ms)
+  virtual unsigned long frameInterval() const = 0;
+
+  const char* getName() const { return name; }
+  void recordTick(unsigned long micros);
+  unsigned long getTicks() const { return ticks; }
+  unsigned long getAverageMicros() const { return ticks ? totalMicros / ticks : 0; }
+  unsigned long getMaxMicros() const { return maxMicros; }
+  unsigned long getOverruns() const { return overruns; }
+  void resetStats();
+};
+
+typedef void (*TaskFunction)(unsigned long now);
+
+// Planificador cooperativo de loop(). En cada tick ejecuta las tareas de
+// fondo vencidas (cada una con su periodo; el plazo es el siguiente periodo)
+// y después la escena activa, midiendo el coste de cada cosa. Los eventos
+// del botón se entregan a la escena que esté activa al sacarlos.
+//
+// setScene() cambia de escena (exit de la anterior, enter de la nueva) y se
+// aplica al momento: si input() cambia de escena, los eventos siguientes,
+// update() y render() ya son de la nueva. interrupt() antepone otra escena
+// sin salir de la actual, que se queda en pausa hasta interrupt(nullptr).
+class Scheduler {
+private:
+  struct Task {
+    const char* name;
+    TaskFunction run;
+    unsigned long period;   // 0 = en cada tick
+    unsigned long nextRun;
+    unsigned long runs;
+    unsigned long lateRuns; // Se ejecutó con un periodo entero de retraso
+    unsigned long totalMicros;
+    unsigned long maxMicros;
+  };
+
+  Task tasks[SCHEDULER_MAX_TASKS];
+  uint8_t taskCount;
+  Scene* scene;       // Escena de base
+  Scene* overlay;     // Escena que la interrumpe (o nullptr)
+  GestureDecoder* gestures;
+  unsigned long now;  // Hora del tick en curso
+
+  void runTasks();
+
+public:
+  Scheduler();
+
+  // Devuelve el índice de la tarea o -1 si no caben más
+  int addTask(const char* name, TaskFunction run, unsigned long period, unsigned long now);
+  unsigned long getNextRun(int task) const { return tasks[task].nextRun; }
+
+  void setInput(GestureDecoder* decoder) { gestures = decoder; }
+  void setScene(Scene* next);
+  void interrupt(Scene* next);
+  Scene* getScene() const { return scene; }
+  Scene* getActiveScene() const { return overlay ? overlay : scene; }
+
+  void tick(unsigned long time);
+
+  void logStats();    // Una línea por tarea y otra para la escena activa
+  void resetStats();
+};
+
+typedef void (*OverlayAction)();
+
+// Pantalla fija durante un tiempo (fin de partida...) sin bloquear loop():
+// las tareas de fondo, el audio y el botón siguen funcionando. Se dibuja una
+// sola vez al mostrarse o al reanudarse tras una interrupción; el resto de
+// ticks no tocan el buffer y no hay nada que enviar por I2C. Al acabar el
+// tiempo, o al pulsar si se puede saltar, llama a done(), que elige la
+// escena siguiente (o muestra otra pantalla con show()).
+class TimedOverlay : public Scene {
+private:
+  OverlayAction draw;
+  OverlayAction done;
+  unsigned long duration;
+  unsigned long shownAt;
+  bool skippable;
+  bool drawn;
+
+public:
+  TimedOverlay(const char* name);
+
+  // Prepara la pantalla; después hay que activarla con setScene()
+  void show(unsigned long now, OverlayAction draw, unsigned long duration, bool skippable, OverlayAction done);
+
+  void enter(unsigned long now) override;
+  void resume(unsigned long now) override { drawn = false; }
+  void input(const ButtonEvent& event) override;
+  void update(unsigned long now) override;
+  void render() override;
+  unsigned long frameInterval() const override;
+};
+
+#endif
@@ -0,0 +1,73 @@
+#ifndef SPRITECACHE_H
+#define SPRITECACHE_H
+
+#include <Arduino.h>
+
+#define SPRITE_CACHE_ENTRIES 8    // Máscaras guardadas a la vez (LRU)
+#define SPRITE_MAX_BYTES 512      // Tamaño máximo de una máscara: ancho x páginas
+#define EYELID_CACHE_ENTRIES 4    // Formas de párpado guardadas a la vez (LRU)
+#define EYELID_MAX_COLUMNS 128    // Ancho máximo de un párpado
+
+// Caché de rectángulos redondeados rasterizados en formato página, indexada
+// por (ancho, alto, radio). Los ojos de RoboEyes usan casi siempre los
+// mismos pocos tamaños (36x36 r8, alturas del parpadeo, ojo curioso), así
+// que la matemática de las esquinas solo se ejecuta en un fallo de caché.
+class RoundRectCache {
+private:
+  struct Entry {
+    int16_t w, h, r;
+    uint32_t lastUse;  // Para expulsar la menos usada recientemente
+    bool valid;
+    uint8_t bits[SPRITE_MAX_BYTES];
+  };
+  
+  Entry entries[SPRITE_CACHE_ENTRIES];
+  uint32_t useClock;
+  unsigned long hits;
+  unsigned long misses;
+  
+public:
+  RoundRectCache();
+  
+  // Máscara de w x h con radio r (ya limitado como en Adafruit_GFX), o
+  // nullptr si no cabe en una entrada
+  const uint8_t* get(int16_t w, int16_t h, int16_t r);
+  void clear();
+  
+  unsigned long getHits() const { return hits; }
+  unsigned long getMisses() const { return misses; }
+  void resetStats();
+};
+
+// Alturas por columna de los párpados de RoboEyes: triángulos rectángulos
+// con el lado horizontal arriba y un lado vertical, indexados por (ancho,
+// alto, lado del vértice). Se calculan con el mismo recorrido por filas que
+// Adafruit_GFX::fillTriangle, así que el resultado es idéntico píxel a píxel.
+class EyelidCache {
+private:
+  struct Entry {
+    int16_t w, h;      // w = x1 - x0 (el triángulo cubre w + 1 columnas), h = y2 - y0
+    bool apexLeft;     // Lado vertical a la izquierda
+    uint32_t lastUse;
+    bool valid;
+    uint8_t heights[EYELID_MAX_COLUMNS + 1];
+  };
+  
+  Entry entries[EYELID_CACHE_ENTRIES];
+  uint32_t useClock;
+  unsigned long hits;
+  unsigned long misses;
+  
+public:
+  EyelidCache();
+  
+  // w + 1 alturas (en filas desde el lado de arriba), o nullptr si no cabe
+  const uint8_t* get(int16_t w, int16_t h, bool apexLeft);
+  void clear();
+  
+  unsigned long getHits() const { return hits; }
+  unsigned long getMisses() const { return misses; }
+  void resetStats();
+};
+
+#endif
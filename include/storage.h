@@ -0,0 +1,77 @@
+#ifndef STORAGE_H
+#define STORAGE_H
+
+#include <Arduino.h>
+#ifdef ARDUINO_ARCH_ESP32
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/queue.h>
+#endif
+
+#define STORAGE_NAME_LEN 16      // NVS admite namespaces y claves de hasta 15 caracteres
+#define STORAGE_SLOTS 16         // Claves distintas que se recuerdan (hoy se usan 12)
+#define STORAGE_QUEUE_SIZE 32    // Escrituras en cola hacia la tarea
+#define STORAGE_BATCH_MS 2000    // Tras la primera escritura se espera esto para agrupar las siguientes
+#define STORAGE_STACK 4096       // Pila de la tarea de persistencia (bytes)
+
+struct StorageWrite {
+  char space[STORAGE_NAME_LEN];
+  char key[STORAGE_NAME_LEN];
+  int32_t value;
+  bool isBool;
+};
+
+// Escrituras en NVS fuera de loop(). put*() solo mete el valor en una cola
+// y vuelve; una tarea de baja prioridad las agrupa durante STORAGE_BATCH_MS,
+// se queda con el último valor de cada clave, descarta los que no han
+// cambiado desde la última escritura y abre cada namespace una sola vez por
+// lote. Así un commit lento de la flash nunca retrasa el botón ni los frames.
+//
+// Las lecturas siguen siendo directas con Preferences (solo al arrancar).
+// Sin FreeRTOS (host) no hay tarea: el lote se escribe desde update().
+class StorageManager {
+private:
+  struct Slot {
+    StorageWrite write;
+    int32_t stored;  // Último valor escrito en NVS
+    bool known;      // stored es válido
+    bool dirty;      // Hay que escribirlo en el próximo lote
+  };
+
+  Slot slots[STORAGE_SLOTS];  // Solo los toca quien escribe los lotes
+  uint8_t slotCount;
+  bool batchOpen;
+  unsigned long batchStart;
+
+  unsigned long batches;   // Lotes escritos
+  unsigned long writes;    // Claves escritas en NVS
+  unsigned long skipped;   // Escrituras descartadas por no cambiar nada
+  unsigned long dropped;   // Cola llena
+#ifdef ARDUINO_ARCH_ESP32
+  QueueHandle_t queue;
+  TaskHandle_t task;
+  static void taskEntry(void* arg);
+#endif
+
+  void put(const char* space, const char* key, int32_t value, bool isBool);
+  void stage(const StorageWrite& write);
+  void commit();
+
+public:
+  StorageManager();
+  bool begin(uint8_t priority = 1);
+
+  void putInt(const char* space, const char* key, int32_t value) { put(space, key, value, false); }
+  void putBool(const char* space, const char* key, bool value) { put(space, key, value, true); }
+
+  void update(unsigned long now);  // Solo sin tarea
+
+  unsigned long getBatches() const { return batches; }
+  unsigned long getWrites() const { return writes; }
+  unsigned long getSkipped() const { return skipped; }
+  unsigned long getDropped() const { return dropped; }
+};
+
+extern StorageManager storage;
+
+#endif
@@ -3,6 +3,10 @@
 
 #include <Arduino.h>
 #include <Preferences.h>
+#include "clock.h"
+#include "storage.h"
+
+#define SLEEP_TICK_MS 5000  // Mientras duerme, el sueño sube un 1% en cada tick
 
 class Tamagotchi {
 private:
@@ -19,8 +23,11 @@ private:
   
   unsigned long lastMinuteUpdate;
   unsigned long sleepStartTime;
+  int minuteCounter;  // El sueño baja cada 2 minutos
+  
+  Clock* clock;  // Tiempo del juego: millis() en el dispositivo, virtual en el host
   
-  Preferences prefs;
+  Preferences prefs;  // Solo para leer al arrancar; se escribe con storage
   unsigned long lastSleepTick; // Para controlar incremento de sueño cada 5 segundos
   
   // Variables para rastrear cuándo se activan los sonidos
@@ -41,7 +48,7 @@ public:
   bool playSleepySound;    // Señal para reproducir sonido de sueño
   
   Tamagotchi();
-  void initialize();
+  void initialize(Clock* clk = &systemClock);
   void update();
   
   // Acciones (retornan true si se ejecutaron)
@@ -64,6 +71,7 @@ public:
   int getSleepiness() const { return sleepiness; }
   int getCoins() const { return coins; }
   bool getIsSleeping() const { return isSleeping; }
+  unsigned long getNextSleepTick() const { return lastSleepTick + SLEEP_TICK_MS; }
   
   // Setters (para modo TEST)
   void setHunger(int h) { hunger = constrain(h, 0, 100); }
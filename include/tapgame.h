@@ -2,6 +2,7 @@
 #define TAPGAME_H
 
 #include <Arduino.h>
+#include "clock.h"
 
 class TapGame {
 private:
@@ -15,9 +16,12 @@ private:
   int targetY;
   unsigned long gameStartTime;
   
+  Clock* clock;
+  Rng* rng;
+  
 public:
   TapGame();
-  void initialize();
+  void initialize(Clock* clk = &systemClock, Rng* rnd = &systemRng);
   void reset();
   void update();
   
@@ -0,0 +1,37 @@
+#ifndef TEXTATLAS_H
+#define TEXTATLAS_H
+
+#include <Arduino.h>
+#include "oled.h"
+
+// Etiquetas fijas de la interfaz pre-rasterizadas (lista en textlabels.h)
+enum TextLabel {
+#define TEXT_LABEL(id, text, size) id,
+#include "textlabels.h"
+#undef TEXT_LABEL
+  LABEL_COUNT
+};
+
+// Posición de una etiqueta dentro del atlas
+struct TextAtlasEntry {
+  uint16_t offset;  // Inicio del bitmap en el pool
+  uint8_t width;    // Ancho en píxeles
+  uint8_t pages;    // Tamaño de texto (1 o 2) = páginas de alto
+};
+
+// Atlas de texto: tools/gentextatlas.py rasteriza cada etiqueta al compilar
+// con la fuente de Adafruit GFX a un bitmap de 1 bpp en formato de páginas
+// (un byte = 8 filas de una columna) que queda en flash (textatlasdata.h).
+// draw() lo copia al buffer byte a byte; no hay nada que construir ni
+// memoria que reservar en tiempo de ejecución.
+class TextAtlas {
+public:
+  // color: SSD1306_WHITE dibuja el texto, SSD1306_BLACK lo recorta de una
+  // barra rellena (variante invertida de la opción resaltada)
+  void draw(OledDisplay* display, TextLabel label, int16_t x, int16_t y, uint16_t color) const;
+  
+  int16_t getWidth(TextLabel label) const;
+  int16_t getHeight(TextLabel label) const;
+};
+
+#endif
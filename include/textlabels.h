@@ -0,0 +1,44 @@
+// Etiquetas fijas de la interfaz: TEXT_LABEL(id, texto, tamaño).
+// Sin guarda de inclusión a propósito: textatlas.h lo incluye para declarar
+// el enum TextLabel y tools/gentextatlas.py lo lee para rasterizar cada
+// texto al compilar. El orden de las líneas es el del enum.
+
+// Menú principal
+TEXT_LABEL(LABEL_TIENDA, "TIENDA", 1)
+TEXT_LABEL(LABEL_JUGAR, "JUGAR", 1)
+TEXT_LABEL(LABEL_DORMIR, "DORMIR", 1)
+TEXT_LABEL(LABEL_SOUND_ON, "SOUND: ON", 1)
+TEXT_LABEL(LABEL_SOUND_OFF, "SOUND: OFF", 1)
+// Tienda
+TEXT_LABEL(LABEL_MONEDAS_PREFIX, "Monedas: ", 1)
+TEXT_LABEL(LABEL_SHOP_MANZANA, "Manzana (10c/+25H)", 1)
+TEXT_LABEL(LABEL_SHOP_PAN, "Pan (15c/+50H)", 1)
+TEXT_LABEL(LABEL_SHOP_QUESO, "Queso (20c/+75H)", 1)
+TEXT_LABEL(LABEL_SHOP_TARTA, "Tarta (25c/+100H)", 1)
+TEXT_LABEL(LABEL_SHOP_MEMORIA, "Juego Memoria (100c)", 1)
+TEXT_LABEL(LABEL_SHOP_TRES_EN_RAYA, "3 en Raya (100c)", 1)
+TEXT_LABEL(LABEL_MONEDAS, "Monedas", 1)
+TEXT_LABEL(LABEL_INSUFICIENTES, "insuficientes", 1)
+// Menú de juegos
+TEXT_LABEL(LABEL_ELIGE_UN_JUEGO, "ELIGE UN JUEGO", 1)
+TEXT_LABEL(LABEL_ESQUIVAR, "ESQUIVAR", 1)
+TEXT_LABEL(LABEL_MEMORIA, "MEMORIA", 1)
+TEXT_LABEL(LABEL_TRES_EN_RAYA, "TRES EN RAYA", 1)
+// Juegos
+TEXT_LABEL(LABEL_LVL_PREFIX, "Lvl: ", 1)
+TEXT_LABEL(LABEL_RCRD_PREFIX, "RCRD:", 1)
+TEXT_LABEL(LABEL_COINS_PREFIX, "Coins: +", 1)
+TEXT_LABEL(LABEL_NIVEL_PREFIX, "Nivel: ", 1)
+TEXT_LABEL(LABEL_NIVEL_ALCANZADO_PREFIX, "Nivel alcanzado: ", 1)
+TEXT_LABEL(LABEL_RECORD_PREFIX, "Record: ", 1)
+TEXT_LABEL(LABEL_MONEDAS_PLUS_PREFIX, "Monedas: +", 1)
+TEXT_LABEL(LABEL_TU_TURNO, "Tu turno", 1)
+TEXT_LABEL(LABEL_PET_JUEGA, "Pet juega...", 1)
+// Tamaño 2
+TEXT_LABEL(LABEL_ZZZ, "ZZZ...", 2)
+TEXT_LABEL(LABEL_GAME_OVER, "GAME OVER", 2)
+TEXT_LABEL(LABEL_OBSERVA, "Observa...", 2)
+TEXT_LABEL(LABEL_REPITE, "REPITE", 2)
+TEXT_LABEL(LABEL_GANASTE, "GANASTE!", 2)
+TEXT_LABEL(LABEL_PERDISTE, "PERDISTE", 2)
+TEXT_LABEL(LABEL_EMPATE, "EMPATE", 2)
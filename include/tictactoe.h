@@ -3,6 +3,10 @@
 
 #include <Arduino.h>
 #include <Preferences.h>
+#include "clock.h"
+#include "storage.h"
+
+#define TIC_TAMAGOTCHI_DELAY_MS 500  // Pausa antes de que mueva el Tamagotchi
 
 // Estados del juego
 enum TicTacToeState {
@@ -28,6 +32,8 @@ enum GameResult {
 };
 
 class TicTacToeGame {
+  friend class RenderBenchmark;  // Prepara estados representativos para medir el render
+  
 private:
   int board[3][3];              // Tablero 3x3 (0=vacío, 1=jugador, 2=tamagotchi)
   int cursorX, cursorY;         // Posición del cursor
@@ -35,12 +41,16 @@ private:
   GameResult result;
   bool playerFirst;             // true si el jugador empieza
   int movesCount;               // Contador de movimientos
+  unsigned long turnStartTime;  // Inicio del turno del Tamagotchi
   
   // Estadísticas
   int wins;                     // Victorias del jugador
   int draws;                    // Empates
   int losses;                   // Derrotas del jugador
-  Preferences prefs;
+  Preferences prefs;            // Solo para leer al arrancar
+  
+  Clock* clock;
+  Rng* rng;
   
   // Para IA del Tamagotchi
   void tamagotchiMove();
@@ -55,7 +65,7 @@ private:
   
 public:
   TicTacToeGame();
-  void initialize();
+  void initialize(Clock* clk = &systemClock, Rng* rnd = &systemRng);
   void reset();
   void update();
   void updateStats(GameResult gameResult);  // Actualizar estadísticas
@@ -0,0 +1,58 @@
+#ifndef TIMELINE_H
+#define TIMELINE_H
+
+#include <Arduino.h>
+
+#define TIMELINE_MAX_EVENTS 72  // Secuencia de memoria más larga: 20 símbolos x 3 eventos + intro
+
+// Tipos de evento de la línea de tiempo
+enum TimelineEventType {
+  TL_EYE_POSE,   // value = EyePose (ojos simples del juego de memoria)
+  TL_EYE_MOOD,   // value = mood de RoboEyes
+  TL_TONE,       // value = frecuencia (Hz), duration = ms
+  TL_TEXT        // value = TextLabel a pantalla completa
+};
+
+struct TimelineEvent {
+  uint16_t at;        // ms desde start()
+  uint8_t type;       // TimelineEventType
+  int16_t value;
+  uint16_t duration;
+};
+
+// Secuenciador de eventos por fotogramas clave. Se programa con add() y se
+// avanza desde loop() con poll(), que entrega los eventos ya vencidos sin
+// bloquear; quien llama decide cómo aplicarlos (pantalla, buzzer...).
+// Sustituye a las secuencias hechas con delay() encadenados.
+class Timeline {
+private:
+  TimelineEvent events[TIMELINE_MAX_EVENTS];  // Ordenados por at
+  uint8_t count;
+  uint8_t nextEvent;          // Primer evento aún no entregado
+  uint16_t length;            // Duración total (ms), al menos el último evento
+  unsigned long startTime;
+  bool running;
+  TimelineEvent view;         // Último evento visual entregado (pose, mood o texto)
+  bool hasView;
+  
+public:
+  Timeline();
+  
+  // Programación: vaciar, añadir eventos y arrancar
+  void clear();
+  bool add(uint16_t at, TimelineEventType type, int16_t value, uint16_t duration = 0);
+  void setLength(uint16_t ms);  // Pausa final tras el último evento
+  void start(unsigned long now);
+  void cancel();                // Descarta los eventos pendientes
+  
+  // Entrega de uno en uno los eventos vencidos; false cuando no quedan por ahora
+  bool poll(unsigned long now, TimelineEvent& out);
+  
+  // true hasta que se entregan todos los eventos y pasa la duración total
+  bool isRunning(unsigned long now);
+  
+  // Lo que debe verse ahora según el último evento visual
+  bool getView(TimelineEvent& out) const;
+};
+
+#endif
@@ -26,16 +26,8 @@
 #ifndef _FLUXGARAGE_ROBOEYES_H
 #define _FLUXGARAGE_ROBOEYES_H
 
+#include "clock.h" // Clock and Rng: time and random sources, swappable for replays
 
-// Display colors - declare as extern if not already declared
-#ifndef ROBOEYES_COLORS_DEFINED
-extern uint8_t BGCOLOR; // background and overlays
-extern uint8_t MAINCOLOR; // drawings
-#define ROBOEYES_COLORS_DEFINED
-#else
-uint8_t BGCOLOR = 0; // background and overlays
-uint8_t MAINCOLOR = 1; // drawings
-#endif
 
 // For mood type switch
 #ifndef DEFAULT
@@ -74,7 +66,8 @@ uint8_t MAINCOLOR = 1; // drawings
 // for middle center set "DEFAULT"
 
 
-// Constructor: takes a reference to the active Adafruit display object (e.g., Adafruit_SSD1327)
+// Constructor: takes a reference to the GFX target to draw on: an Adafruit display
+// object (e.g., Adafruit_SSD1327) or an off-screen canvas such as GFXcanvas1
 // Eg: roboEyes<Adafruit_SSD1327> = eyes(display);
 template<typename AdafruitDisplay>
 class RoboEyes
@@ -85,14 +78,24 @@ private:
 
 public:
 
-// Reference to Adafruit display object
+// Reference to Adafruit display object or canvas
 AdafruitDisplay *display;
 
+// Time and random sources, clock->now() and rng->next() unless setClock() swaps them
+Clock *clock = &systemClock;
+Rng *rng = &systemRng;
+
+// Display colors, per instance
+uint8_t bgColor = 0; // background and overlays
+uint8_t mainColor = 1; // drawings
+
 // For general setup - screen size and max. frame rate
 int screenWidth = 128; // OLED display width, in pixels
 int screenHeight = 64; // OLED display height, in pixels
 int frameInterval = 20; // default value for 50 frames per second (1000/50 = 20 milliseconds)
 unsigned long fpsTimer = 0; // for timing the frames per second
+bool autoFlush = 1; // if false, drawEyes() only renders into the buffer and the caller pushes it to the display
+bool tweenExternally = 0; // if true, sizes, positions and eyelids jump to their targets each frame: the caller animates the targets over time
 
 // For controlling mood types and expressions
 bool tired = 0;
@@ -209,32 +212,44 @@ int laughAnimationDuration = 500;
 bool laughToggle = 1;
 
 // Animation - sweat on the forehead
+// Sub-pixel state is fixed point (the ESP32-C3 has no FPU): SWEAT_FX units per
+// pixel, chosen so the 0.5px and 0.1px steps are exact. Integer division
+// truncates towards zero like the float-to-int conversion it replaces.
+static const int SWEAT_FX = 20;
 bool sweat = 0;
 byte sweatBorderradius = 3;
 
 // Sweat drop 1
 int sweat1XPosInitial = 2;
 int sweat1XPos;
-float sweat1YPos = 2;
+int sweat1YPos = 2*SWEAT_FX;
 int sweat1YPosMax;
-float sweat1Height = 2;
-float sweat1Width = 1;
+int sweat1Height = 2*SWEAT_FX;
+int sweat1Width = SWEAT_FX;
 
 // Sweat drop 2
 int sweat2XPosInitial = 2;
 int sweat2XPos;
-float sweat2YPos = 2;
+int sweat2YPos = 2*SWEAT_FX;
 int sweat2YPosMax;
-float sweat2Height = 2;
-float sweat2Width = 1;
+int sweat2Height = 2*SWEAT_FX;
+int sweat2Width = SWEAT_FX;
 
 // Sweat drop 3
 int sweat3XPosInitial = 2;
 int sweat3XPos;
-float sweat3YPos = 2;
+int sweat3YPos = 2*SWEAT_FX;
 int sweat3YPosMax;
-float sweat3Height = 2;
-float sweat3Width = 1;
+int sweat3Height = 2*SWEAT_FX;
+int sweat3Width = SWEAT_FX;
+
+// At-rest detection: once a frame leaves the tweening state unchanged and no
+// flicker/sweat/one-shot animation is running, every following frame draws the
+// same image until blinktimer or idleAnimationTimer fires.
+static const int REST_STATE_SIZE = 36;
+int restState[REST_STATE_SIZE]; // state left behind by the last drawEyes()
+int restStateBefore[REST_STATE_SIZE]; // state at the start of the frame being drawn
+bool restValid = 0; // last frame was converged and the buffer still holds it
 
 
 //*********************************************************************************************
@@ -247,19 +262,56 @@ RoboEyes(AdafruitDisplay &disp) : display(&disp) {};
 void begin(int width, int height, byte frameRate) {
 	screenWidth = width; // OLED display width, in pixels
 	screenHeight = height; // OLED display height, in pixels
-  display->clearDisplay(); // clear the display buffer
-  display->display(); // show empty screen
+  display->fillScreen(bgColor); // clear the display buffer
+  flushTarget(display, 0); // show empty screen
   eyeLheightCurrent = 1; // start with closed eyes
   eyeRheightCurrent = 1; // start with closed eyes
   setFramerate(frameRate); // calculate frame interval based on defined frameRate
 }
 
-void update(){
+// Use other time and random sources, e.g. a manual clock and a seeded generator
+void setClock(Clock *clk, Rng *rnd){
+  clock = clk;
+  rng = rnd;
+}
+
+// Returns true if a new frame was drawn
+bool update(){
+  if(!frameDue()) return false;
+  drawEyes();
+  return true;
+}
+
+// True if the max framerate allows a new frame and it would differ from the last one
+bool frameDue(){
   // Limit drawing updates to defined max framerate
-  if(millis()-fpsTimer >= frameInterval){
-    drawEyes();
-    fpsTimer = millis();
-  }
+  if(clock->now()-fpsTimer < frameInterval) return false;
+  // Converged: the buffer already holds this frame
+  return !isAtRest();
+}
+
+
+// True if drawing now would repeat the last frame: nothing has moved since,
+// no setter touched the state and no timer is due
+bool isAtRest(){
+  if(!restValid) return false;
+  if(clock->now() >= nextChangeAt()) return false;
+  int now[REST_STATE_SIZE];
+  captureRestState(now);
+  return memcmp(now, restState, sizeof(now)) == 0;
+}
+
+// Next time a timed animation will change the eyes while at rest
+unsigned long nextChangeAt(){
+  unsigned long next = (unsigned long)-1;
+  if(autoblinker && blinktimer < next){next = blinktimer;}
+  if(idle && idleAnimationTimer < next){next = idleAnimationTimer;}
+  return next;
+}
+
+// Call when something else drew over the buffer: the next update() redraws
+void invalidate(){
+  restValid = 0;
 }
 
 
@@ -272,10 +324,22 @@ void setFramerate(byte fps){
   frameInterval = 1000/fps;
 }
 
+// Render-only mode: drawEyes() draws into the buffer without calling display->display().
+// Targets without display() (canvases) are never flushed.
+void setAutoFlush(bool active) {
+  autoFlush = active;
+}
+
+// If true, the caller animates sizes, positions, curious offsets and eyelid
+// heights itself and each frame shows the targets as they are
+void setExternalTweening(bool active) {
+  tweenExternally = active;
+}
+
 // Set color values
 void setDisplayColors(uint8_t background, uint8_t main) {
-  BGCOLOR = background; // background and overlays, choose 0 for monochrome displays and 0x00 for grayscale displays such as SSD1322
-  MAINCOLOR = main; // drawings, choose 1 for monochrome displays and 0x0F for grayscale displays such as SSD1322 (0x0F = maximum brightness)
+  bgColor = background; // background and overlays, choose 0 for monochrome displays and 0x00 for grayscale displays such as SSD1322
+  mainColor = main; // drawings, choose 1 for monochrome displays and 0x0F for grayscale displays such as SSD1322 (0x0F = maximum brightness)
 }
 
 void setWidth(byte leftEye, byte rightEye) {
@@ -538,70 +602,36 @@ void anim_laugh() {
 //  PRE-CALCULATIONS AND ACTUAL DRAWINGS
 //*********************************************************************************************
 
+// Draw one frame. Callers compositing the eyes can instead call prepareFrame(),
+// read getFrameBounds() to place their canvas and then call renderFrame().
 void drawEyes(){
+  prepareFrame();
+  renderFrame();
+}
 
-  //// PRE-CALCULATIONS - EYE SIZES AND VALUES FOR ANIMATION TWEENINGS ////
+// Advance tweenings and animations for the next frame, without drawing
+void prepareFrame(){
 
-  // Vertical size offset for larger eyes when looking left or right (curious gaze)
-  if(curious){
-    if(eyeLxNext<=10){eyeLheightOffset=8;}
-    else if (eyeLxNext>=(getScreenConstraint_X()-10) && cyclops){eyeLheightOffset=8;}
-    else{eyeLheightOffset=0;} // left eye
-    if(eyeRxNext>=screenWidth-eyeRwidthCurrent-10){eyeRheightOffset=8;}
-    else{eyeRheightOffset=0;} // right eye
-  } else {
-    eyeLheightOffset=0; // reset height offset for left eye
-    eyeRheightOffset=0; // reset height offset for right eye
-  }
-
-  // Left eye height
-  eyeLheightCurrent = (eyeLheightCurrent + eyeLheightNext + eyeLheightOffset)/2;
-  eyeLy+= ((eyeLheightDefault-eyeLheightCurrent)/2); // vertical centering of eye when closing
-  eyeLy-= eyeLheightOffset/2;
-  // Right eye height
-  eyeRheightCurrent = (eyeRheightCurrent + eyeRheightNext + eyeRheightOffset)/2;
-  eyeRy+= (eyeRheightDefault-eyeRheightCurrent)/2; // vertical centering of eye when closing
-  eyeRy-= eyeRheightOffset/2;
+  fpsTimer = clock->now();
+  captureRestState(restStateBefore);
 
+  //// PRE-CALCULATIONS - EYE SIZES AND VALUES FOR ANIMATION TWEENINGS ////
 
-  // Open eyes again after closing them
-	if(eyeL_open){
-  	if(eyeLheightCurrent <= 1 + eyeLheightOffset){eyeLheightNext = eyeLheightDefault;} 
-  }
-  if(eyeR_open){
-  	if(eyeRheightCurrent <= 1 + eyeRheightOffset){eyeRheightNext = eyeRheightDefault;} 
+  // Targets are already this frame's values: the caller blends them over
+  // time (including eyelids and the curious height offsets)
+  if(tweenExternally){
+    snapToTargets();
+  } else {
+    tweenToTargets();
   }
 
-  // Left eye width
-  eyeLwidthCurrent = (eyeLwidthCurrent + eyeLwidthNext)/2;
-  // Right eye width
-  eyeRwidthCurrent = (eyeRwidthCurrent + eyeRwidthNext)/2;
-
-
-  // Space between eyes
-  spaceBetweenCurrent = (spaceBetweenCurrent + spaceBetweenNext)/2;
-
-  // Left eye coordinates
-  eyeLx = (eyeLx + eyeLxNext)/2;
-  eyeLy = (eyeLy + eyeLyNext)/2;
-  // Right eye coordinates
-  eyeRxNext = eyeLxNext+eyeLwidthCurrent+spaceBetweenCurrent; // right eye's x position depends on left eyes position + the space between
-  eyeRyNext = eyeLyNext; // right eye's y position should be the same as for the left eye
-  eyeRx = (eyeRx + eyeRxNext)/2;
-  eyeRy = (eyeRy + eyeRyNext)/2;
-
-  // Left eye border radius
-  eyeLborderRadiusCurrent = (eyeLborderRadiusCurrent + eyeLborderRadiusNext)/2;
-  // Right eye border radius
-  eyeRborderRadiusCurrent = (eyeRborderRadiusCurrent + eyeRborderRadiusNext)/2;
-  
 
   //// APPLYING MACRO ANIMATIONS ////
 
 	if(autoblinker){
-		if(millis() >= blinktimer){
+		if(clock->now() >= blinktimer){
 		blink();
-		blinktimer = millis()+(blinkInterval*1000)+(random(blinkIntervalVariation)*1000); // calculate next time for blinking
+		blinktimer = clock->now()+(blinkInterval*1000)+(rng->next(blinkIntervalVariation)*1000); // calculate next time for blinking
 		}
 	}
 
@@ -609,9 +639,9 @@ void drawEyes(){
   if(laugh){
     if(laughToggle){
       setVFlicker(1, 5);
-      laughAnimationTimer = millis();
+      laughAnimationTimer = clock->now();
       laughToggle = 0;
-    } else if(millis() >= laughAnimationTimer+laughAnimationDuration){
+    } else if(clock->now() >= laughAnimationTimer+laughAnimationDuration){
       setVFlicker(0, 0);
       laughToggle = 1;
       laugh=0; 
@@ -622,9 +652,9 @@ void drawEyes(){
   if(confused){
     if(confusedToggle){
       setHFlicker(1, 20);
-      confusedAnimationTimer = millis();
+      confusedAnimationTimer = clock->now();
       confusedToggle = 0;
-    } else if(millis() >= confusedAnimationTimer+confusedAnimationDuration){
+    } else if(clock->now() >= confusedAnimationTimer+confusedAnimationDuration){
       setHFlicker(0, 0);
       confusedToggle = 1;
       confused=0; 
@@ -633,10 +663,10 @@ void drawEyes(){
 
   // Idle - eyes moving to random positions on screen
   if(idle){
-    if(millis() >= idleAnimationTimer){
-      eyeLxNext = random(getScreenConstraint_X());
-      eyeLyNext = random(getScreenConstraint_Y());
-      idleAnimationTimer = millis()+(idleInterval*1000)+(random(idleIntervalVariation)*1000); // calculate next time for eyes repositioning
+    if(clock->now() >= idleAnimationTimer){
+      eyeLxNext = rng->next(getScreenConstraint_X());
+      eyeLyNext = rng->next(getScreenConstraint_Y());
+      idleAnimationTimer = clock->now()+(idleInterval*1000)+(rng->next(idleIntervalVariation)*1000); // calculate next time for eyes repositioning
     }
   }
 
@@ -671,94 +701,244 @@ void drawEyes(){
     spaceBetweenCurrent = 0;
   }
 
+  // Sweat drops movement
+  if (sweat){
+    // Sweat drop 1 -> left corner
+    if(sweat1YPos <= sweat1YPosMax*SWEAT_FX){sweat1YPos+=SWEAT_FX/2;} // vertical movement from initial to max
+    else {sweat1XPosInitial = rng->next(30); sweat1YPos = 2*SWEAT_FX; sweat1YPosMax = (rng->next(10)+10); sweat1Width = SWEAT_FX; sweat1Height = 2*SWEAT_FX;} // if max vertical position is reached: reset all values for next drop
+    if(sweat1YPos <= (sweat1YPosMax/2)*SWEAT_FX){sweat1Width+=SWEAT_FX/2; sweat1Height+=SWEAT_FX/2;} // shape grows in first half of animation ...
+    else {sweat1Width-=SWEAT_FX/10; sweat1Height-=SWEAT_FX/2;} // ... and shrinks in second half of animation
+    sweat1XPos = (sweat1XPosInitial*SWEAT_FX-(sweat1Width/2))/SWEAT_FX; // keep the growing shape centered to initial x position
+
+    // Sweat drop 2 -> center area
+    if(sweat2YPos <= sweat2YPosMax*SWEAT_FX){sweat2YPos+=SWEAT_FX/2;} // vertical movement from initial to max
+    else {sweat2XPosInitial = rng->next((screenWidth-60))+30; sweat2YPos = 2*SWEAT_FX; sweat2YPosMax = (rng->next(10)+10); sweat2Width = SWEAT_FX; sweat2Height = 2*SWEAT_FX;} // if max vertical position is reached: reset all values for next drop
+    if(sweat2YPos <= (sweat2YPosMax/2)*SWEAT_FX){sweat2Width+=SWEAT_FX/2; sweat2Height+=SWEAT_FX/2;} // shape grows in first half of animation ...
+    else {sweat2Width-=SWEAT_FX/10; sweat2Height-=SWEAT_FX/2;} // ... and shrinks in second half of animation
+    sweat2XPos = (sweat2XPosInitial*SWEAT_FX-(sweat2Width/2))/SWEAT_FX; // keep the growing shape centered to initial x position
+
+    // Sweat drop 3 -> right corner
+    if(sweat3YPos <= sweat3YPosMax*SWEAT_FX){sweat3YPos+=SWEAT_FX/2;} // vertical movement from initial to max
+    else {sweat3XPosInitial = (screenWidth-30)+(rng->next(30)); sweat3YPos = 2*SWEAT_FX; sweat3YPosMax = (rng->next(10)+10); sweat3Width = SWEAT_FX; sweat3Height = 2*SWEAT_FX;} // if max vertical position is reached: reset all values for next drop
+    if(sweat3YPos <= (sweat3YPosMax/2)*SWEAT_FX){sweat3Width+=SWEAT_FX/2; sweat3Height+=SWEAT_FX/2;} // shape grows in first half of animation ...
+    else {sweat3Width-=SWEAT_FX/10; sweat3Height-=SWEAT_FX/2;} // ... and shrinks in second half of animation
+    sweat3XPos = (sweat3XPosInitial*SWEAT_FX-(sweat3Width/2))/SWEAT_FX; // keep the growing shape centered to initial x position
+  }
+
+} // end of prepareFrame method
+
+// Default tweening: every frame each value moves halfway to its target
+void tweenToTargets(){
+
+  // Vertical size offset for larger eyes when looking left or right (curious gaze)
+  if(curious){
+    if(eyeLxNext<=10){eyeLheightOffset=8;}
+    else if (eyeLxNext>=(getScreenConstraint_X()-10) && cyclops){eyeLheightOffset=8;}
+    else{eyeLheightOffset=0;} // left eye
+    if(eyeRxNext>=screenWidth-eyeRwidthCurrent-10){eyeRheightOffset=8;}
+    else{eyeRheightOffset=0;} // right eye
+  } else {
+    eyeLheightOffset=0; // reset height offset for left eye
+    eyeRheightOffset=0; // reset height offset for right eye
+  }
+
+  // Left eye height
+  eyeLheightCurrent = (eyeLheightCurrent + eyeLheightNext + eyeLheightOffset)/2;
+  eyeLy+= ((eyeLheightDefault-eyeLheightCurrent)/2); // vertical centering of eye when closing
+  eyeLy-= eyeLheightOffset/2;
+  // Right eye height
+  eyeRheightCurrent = (eyeRheightCurrent + eyeRheightNext + eyeRheightOffset)/2;
+  eyeRy+= (eyeRheightDefault-eyeRheightCurrent)/2; // vertical centering of eye when closing
+  eyeRy-= eyeRheightOffset/2;
+
+
+  // Open eyes again after closing them
+	if(eyeL_open){
+  	if(eyeLheightCurrent <= 1 + eyeLheightOffset){eyeLheightNext = eyeLheightDefault;} 
+  }
+  if(eyeR_open){
+  	if(eyeRheightCurrent <= 1 + eyeRheightOffset){eyeRheightNext = eyeRheightDefault;} 
+  }
+
+  // Left eye width
+  eyeLwidthCurrent = (eyeLwidthCurrent + eyeLwidthNext)/2;
+  // Right eye width
+  eyeRwidthCurrent = (eyeRwidthCurrent + eyeRwidthNext)/2;
+
+
+  // Space between eyes
+  spaceBetweenCurrent = (spaceBetweenCurrent + spaceBetweenNext)/2;
+
+  // Left eye coordinates
+  eyeLx = (eyeLx + eyeLxNext)/2;
+  eyeLy = (eyeLy + eyeLyNext)/2;
+  // Right eye coordinates
+  eyeRxNext = eyeLxNext+eyeLwidthCurrent+spaceBetweenCurrent; // right eye's x position depends on left eyes position + the space between
+  eyeRyNext = eyeLyNext; // right eye's y position should be the same as for the left eye
+  eyeRx = (eyeRx + eyeRxNext)/2;
+  eyeRy = (eyeRy + eyeRyNext)/2;
+
+  // Left eye border radius
+  eyeLborderRadiusCurrent = (eyeLborderRadiusCurrent + eyeLborderRadiusNext)/2;
+  // Right eye border radius
+  eyeRborderRadiusCurrent = (eyeRborderRadiusCurrent + eyeRborderRadiusNext)/2;
+
+} // end of tweenToTargets method
+
+// External tweening: current values are the targets. Same resting positions
+// as tweenToTargets(), without the per-frame halving.
+void snapToTargets(){
+  eyeLheightCurrent = eyeLheightNext + eyeLheightOffset;
+  eyeRheightCurrent = eyeRheightNext + eyeRheightOffset;
+  eyeLwidthCurrent = eyeLwidthNext;
+  eyeRwidthCurrent = eyeRwidthNext;
+  spaceBetweenCurrent = spaceBetweenNext;
+
+  // Vertical centering of the eyes when closing, as in tweenToTargets()
+  eyeLx = eyeLxNext;
+  eyeLy = eyeLyNext + (eyeLheightDefault-eyeLheightCurrent)/2 - eyeLheightOffset/2;
+  eyeRxNext = eyeLxNext+eyeLwidthCurrent+spaceBetweenCurrent;
+  eyeRyNext = eyeLyNext;
+  eyeRx = eyeRxNext;
+  eyeRy = eyeRyNext + (eyeRheightDefault-eyeRheightCurrent)/2 - eyeRheightOffset/2;
+
+  eyeLborderRadiusCurrent = eyeLborderRadiusNext;
+  eyeRborderRadiusCurrent = eyeRborderRadiusNext;
+}
+
+// Area that renderFrame() will draw in mainColor; the rest of the target is
+// left as bgColor. Eyelids only erase inside or right next to the eyes.
+// Sweat drops can land anywhere near the top edge, so with sweat on the
+// bounds are the whole screen.
+void getFrameBounds(int16_t &x, int16_t &y, int16_t &w, int16_t &h){
+  if(sweat){
+    x = 0; y = 0; w = screenWidth; h = screenHeight;
+    return;
+  }
+  int x0 = eyeLx, y0 = eyeLy;
+  int x1 = eyeLx + eyeLwidthCurrent, y1 = eyeLy + eyeLheightCurrent;
+  if(!cyclops){
+    x0 = min(x0, eyeRx); y0 = min(y0, eyeRy);
+    x1 = max(x1, eyeRx + eyeRwidthCurrent); y1 = max(y1, eyeRy + eyeRheightCurrent);
+  }
+  x = x0; y = y0; w = x1 - x0; h = y1 - y0;
+}
+
+// Draw the frame computed by prepareFrame()
+void renderFrame(){
+
   //// ACTUAL DRAWINGS ////
 
-  display->clearDisplay(); // start with a blank screen
+  display->fillScreen(bgColor); // start with a blank screen
 
   // Draw basic eye rectangles
-  display->fillRoundRect(eyeLx, eyeLy, eyeLwidthCurrent, eyeLheightCurrent, eyeLborderRadiusCurrent, MAINCOLOR); // left eye
+  display->fillRoundRect(eyeLx, eyeLy, eyeLwidthCurrent, eyeLheightCurrent, eyeLborderRadiusCurrent, mainColor); // left eye
   if (!cyclops){
-    display->fillRoundRect(eyeRx, eyeRy, eyeRwidthCurrent, eyeRheightCurrent, eyeRborderRadiusCurrent, MAINCOLOR); // right eye
+    display->fillRoundRect(eyeRx, eyeRy, eyeRwidthCurrent, eyeRheightCurrent, eyeRborderRadiusCurrent, mainColor); // right eye
   }
 
-  // Prepare mood type transitions
-  if (tired){eyelidsTiredHeightNext = eyeLheightCurrent/2; eyelidsAngryHeightNext = 0;} else{eyelidsTiredHeightNext = 0;}
-  if (sleepy){eyelidsSleepyHeightNext = (eyeLheightCurrent * 0.4); eyelidsAngryHeightNext = 0;} else{eyelidsSleepyHeightNext = 0;}
-  if (angry){eyelidsAngryHeightNext = eyeLheightCurrent/2; eyelidsTiredHeightNext = 0;} else{eyelidsAngryHeightNext = 0;}
-  if (happy){eyelidsHappyBottomOffsetNext = eyeLheightCurrent/2;} else{eyelidsHappyBottomOffsetNext = 0;}
+  // Prepare mood type transitions (with external tweening the caller sets the eyelid heights)
+  if (!tweenExternally){
+    if (tired){eyelidsTiredHeightNext = eyeLheightCurrent/2; eyelidsAngryHeightNext = 0;} else{eyelidsTiredHeightNext = 0;}
+    if (sleepy){eyelidsSleepyHeightNext = (eyeLheightCurrent * 2) / 5; eyelidsAngryHeightNext = 0;} else{eyelidsSleepyHeightNext = 0;}
+    if (angry){eyelidsAngryHeightNext = eyeLheightCurrent/2; eyelidsTiredHeightNext = 0;} else{eyelidsAngryHeightNext = 0;}
+    if (happy){eyelidsHappyBottomOffsetNext = eyeLheightCurrent/2;} else{eyelidsHappyBottomOffsetNext = 0;}
+    eyelidsTiredHeight = (eyelidsTiredHeight + eyelidsTiredHeightNext)/2;
+    eyelidsSleepyHeight = (eyelidsSleepyHeight + eyelidsSleepyHeightNext)/2;
+    eyelidsAngryHeight = (eyelidsAngryHeight + eyelidsAngryHeightNext)/2;
+    eyelidsHappyBottomOffset = (eyelidsHappyBottomOffset + eyelidsHappyBottomOffsetNext)/2;
+  }
 
   // Draw tired top eyelids 
-    eyelidsTiredHeight = (eyelidsTiredHeight + eyelidsTiredHeightNext)/2;
     if (!cyclops){
-      display->fillTriangle(eyeLx, eyeLy-1, eyeLx+eyeLwidthCurrent, eyeLy-1, eyeLx, eyeLy+eyelidsTiredHeight-1, BGCOLOR); // left eye 
-      display->fillTriangle(eyeRx, eyeRy-1, eyeRx+eyeRwidthCurrent, eyeRy-1, eyeRx+eyeRwidthCurrent, eyeRy+eyelidsTiredHeight-1, BGCOLOR); // right eye
+      display->fillTriangle(eyeLx, eyeLy-1, eyeLx+eyeLwidthCurrent, eyeLy-1, eyeLx, eyeLy+eyelidsTiredHeight-1, bgColor); // left eye 
+      display->fillTriangle(eyeRx, eyeRy-1, eyeRx+eyeRwidthCurrent, eyeRy-1, eyeRx+eyeRwidthCurrent, eyeRy+eyelidsTiredHeight-1, bgColor); // right eye
     } else {
       // Cyclops tired eyelids
-      display->fillTriangle(eyeLx, eyeLy-1, eyeLx+(eyeLwidthCurrent/2), eyeLy-1, eyeLx, eyeLy+eyelidsTiredHeight-1, BGCOLOR); // left eyelid half
-      display->fillTriangle(eyeLx+(eyeLwidthCurrent/2), eyeLy-1, eyeLx+eyeLwidthCurrent, eyeLy-1, eyeLx+eyeLwidthCurrent, eyeLy+eyelidsTiredHeight-1, BGCOLOR); // right eyelid half
+      display->fillTriangle(eyeLx, eyeLy-1, eyeLx+(eyeLwidthCurrent/2), eyeLy-1, eyeLx, eyeLy+eyelidsTiredHeight-1, bgColor); // left eyelid half
+      display->fillTriangle(eyeLx+(eyeLwidthCurrent/2), eyeLy-1, eyeLx+eyeLwidthCurrent, eyeLy-1, eyeLx+eyeLwidthCurrent, eyeLy+eyelidsTiredHeight-1, bgColor); // right eyelid half
     }
 
   // Draw sleepy top eyelids (50% closed)
-    eyelidsSleepyHeight = (eyelidsSleepyHeight + eyelidsSleepyHeightNext)/2;
     if (!cyclops){
       // Dibuja un rectángulo (cuadrado) como párpado superior en modo SLEEPY
-      display->fillRect(eyeLx, eyeLy-1, eyeLwidthCurrent, eyelidsSleepyHeight, BGCOLOR); // left eye
-      display->fillRect(eyeRx, eyeRy-1, eyeRwidthCurrent, eyelidsSleepyHeight, BGCOLOR); // right eye
+      display->fillRect(eyeLx, eyeLy-1, eyeLwidthCurrent, eyelidsSleepyHeight, bgColor); // left eye
+      display->fillRect(eyeRx, eyeRy-1, eyeRwidthCurrent, eyelidsSleepyHeight, bgColor); // right eye
     } else {
       // Cyclops sleepy eyelids (rectángulo)
-      display->fillRect(eyeLx, eyeLy-1, eyeLwidthCurrent, eyelidsSleepyHeight, BGCOLOR);
+      display->fillRect(eyeLx, eyeLy-1, eyeLwidthCurrent, eyelidsSleepyHeight, bgColor);
     }
 
   // Draw angry top eyelids 
-    eyelidsAngryHeight = (eyelidsAngryHeight + eyelidsAngryHeightNext)/2;
     if (!cyclops){ 
-      display->fillTriangle(eyeLx, eyeLy-1, eyeLx+eyeLwidthCurrent, eyeLy-1, eyeLx+eyeLwidthCurrent, eyeLy+eyelidsAngryHeight-1, BGCOLOR); // left eye
-      display->fillTriangle(eyeRx, eyeRy-1, eyeRx+eyeRwidthCurrent, eyeRy-1, eyeRx, eyeRy+eyelidsAngryHeight-1, BGCOLOR); // right eye
+      display->fillTriangle(eyeLx, eyeLy-1, eyeLx+eyeLwidthCurrent, eyeLy-1, eyeLx+eyeLwidthCurrent, eyeLy+eyelidsAngryHeight-1, bgColor); // left eye
+      display->fillTriangle(eyeRx, eyeRy-1, eyeRx+eyeRwidthCurrent, eyeRy-1, eyeRx, eyeRy+eyelidsAngryHeight-1, bgColor); // right eye
     } else {
       // Cyclops angry eyelids
-      display->fillTriangle(eyeLx, eyeLy-1, eyeLx+(eyeLwidthCurrent/2), eyeLy-1, eyeLx+(eyeLwidthCurrent/2), eyeLy+eyelidsAngryHeight-1, BGCOLOR); // left eyelid half
-      display->fillTriangle(eyeLx+(eyeLwidthCurrent/2), eyeLy-1, eyeLx+eyeLwidthCurrent, eyeLy-1, eyeLx+(eyeLwidthCurrent/2), eyeLy+eyelidsAngryHeight-1, BGCOLOR); // right eyelid half
+      display->fillTriangle(eyeLx, eyeLy-1, eyeLx+(eyeLwidthCurrent/2), eyeLy-1, eyeLx+(eyeLwidthCurrent/2), eyeLy+eyelidsAngryHeight-1, bgColor); // left eyelid half
+      display->fillTriangle(eyeLx+(eyeLwidthCurrent/2), eyeLy-1, eyeLx+eyeLwidthCurrent, eyeLy-1, eyeLx+(eyeLwidthCurrent/2), eyeLy+eyelidsAngryHeight-1, bgColor); // right eyelid half
     }
 
   // Draw happy bottom eyelids
-    eyelidsHappyBottomOffset = (eyelidsHappyBottomOffset + eyelidsHappyBottomOffsetNext)/2;
-    display->fillRoundRect(eyeLx-1, (eyeLy+eyeLheightCurrent)-eyelidsHappyBottomOffset+1, eyeLwidthCurrent+2, eyeLheightDefault, eyeLborderRadiusCurrent, BGCOLOR); // left eye
+    display->fillRoundRect(eyeLx-1, (eyeLy+eyeLheightCurrent)-eyelidsHappyBottomOffset+1, eyeLwidthCurrent+2, eyeLheightDefault, eyeLborderRadiusCurrent, bgColor); // left eye
     if (!cyclops){ 
-      display->fillRoundRect(eyeRx-1, (eyeRy+eyeRheightCurrent)-eyelidsHappyBottomOffset+1, eyeRwidthCurrent+2, eyeRheightDefault, eyeRborderRadiusCurrent, BGCOLOR); // right eye
+      display->fillRoundRect(eyeRx-1, (eyeRy+eyeRheightCurrent)-eyelidsHappyBottomOffset+1, eyeRwidthCurrent+2, eyeRheightDefault, eyeRborderRadiusCurrent, bgColor); // right eye
     }
 
   // Add sweat drops
     if (sweat){
       // Sweat drop 1 -> left corner
-      if(sweat1YPos <= sweat1YPosMax){sweat1YPos+=0.5;} // vertical movement from initial to max
-      else {sweat1XPosInitial = random(30); sweat1YPos = 2; sweat1YPosMax = (random(10)+10); sweat1Width = 1; sweat1Height = 2;} // if max vertical position is reached: reset all values for next drop
-      if(sweat1YPos <= sweat1YPosMax/2){sweat1Width+=0.5; sweat1Height+=0.5;} // shape grows in first half of animation ...
-      else {sweat1Width-=0.1; sweat1Height-=0.5;} // ... and shrinks in second half of animation
-      sweat1XPos = sweat1XPosInitial-(sweat1Width/2); // keep the growing shape centered to initial x position
-      display->fillRoundRect(sweat1XPos, sweat1YPos, sweat1Width, sweat1Height, sweatBorderradius, MAINCOLOR); // draw sweat drop
-
-
+      display->fillRoundRect(sweat1XPos, sweat1YPos/SWEAT_FX, sweat1Width/SWEAT_FX, sweat1Height/SWEAT_FX, sweatBorderradius, mainColor); // draw sweat drop
       // Sweat drop 2 -> center area
-      if(sweat2YPos <= sweat2YPosMax){sweat2YPos+=0.5;} // vertical movement from initial to max
-      else {sweat2XPosInitial = random((screenWidth-60))+30; sweat2YPos = 2; sweat2YPosMax = (random(10)+10); sweat2Width = 1; sweat2Height = 2;} // if max vertical position is reached: reset all values for next drop
-      if(sweat2YPos <= sweat2YPosMax/2){sweat2Width+=0.5; sweat2Height+=0.5;} // shape grows in first half of animation ...
-      else {sweat2Width-=0.1; sweat2Height-=0.5;} // ... and shrinks in second half of animation
-      sweat2XPos = sweat2XPosInitial-(sweat2Width/2); // keep the growing shape centered to initial x position
-      display->fillRoundRect(sweat2XPos, sweat2YPos, sweat2Width, sweat2Height, sweatBorderradius, MAINCOLOR); // draw sweat drop
-
-
+      display->fillRoundRect(sweat2XPos, sweat2YPos/SWEAT_FX, sweat2Width/SWEAT_FX, sweat2Height/SWEAT_FX, sweatBorderradius, mainColor); // draw sweat drop
       // Sweat drop 3 -> right corner
-      if(sweat3YPos <= sweat3YPosMax){sweat3YPos+=0.5;} // vertical movement from initial to max
-      else {sweat3XPosInitial = (screenWidth-30)+(random(30)); sweat3YPos = 2; sweat3YPosMax = (random(10)+10); sweat3Width = 1; sweat3Height = 2;} // if max vertical position is reached: reset all values for next drop
-      if(sweat3YPos <= sweat3YPosMax/2){sweat3Width+=0.5; sweat3Height+=0.5;} // shape grows in first half of animation ...
-      else {sweat3Width-=0.1; sweat3Height-=0.5;} // ... and shrinks in second half of animation
-      sweat3XPos = sweat3XPosInitial-(sweat3Width/2); // keep the growing shape centered to initial x position
-      display->fillRoundRect(sweat3XPos, sweat3YPos, sweat3Width, sweat3Height, sweatBorderradius, MAINCOLOR); // draw sweat drop
+      display->fillRoundRect(sweat3XPos, sweat3YPos/SWEAT_FX, sweat3Width/SWEAT_FX, sweat3Height/SWEAT_FX, sweatBorderradius, mainColor); // draw sweat drop
     }
 
-  display->display(); // show drawings on display
+  if(autoFlush){
+    flushTarget(display, 0); // show drawings on display
+  }
+
+  // Converged if this frame left the state as it found it
+  captureRestState(restState);
+  restValid = !hFlicker && !vFlicker && !sweat && !laugh && !confused &&
+              memcmp(restStateBefore, restState, sizeof(restState)) == 0;
+
+} // end of renderFrame method
 
-} // end of drawEyes method
+// Push the buffer to the panel on targets that have display(); canvases have none
+template<typename Target>
+static auto flushTarget(Target *target, int) -> decltype(target->display(), void()){
+  target->display();
+}
+template<typename Target>
+static void flushTarget(Target *target, long){
+}
+
+// Everything drawEyes() reads besides the timers. The image only depends on
+// these values, so equal snapshots mean equal frames.
+void captureRestState(int* s){
+  int i = 0;
+  s[i++] = eyeLwidthCurrent; s[i++] = eyeLwidthNext;
+  s[i++] = eyeLheightCurrent; s[i++] = eyeLheightNext; s[i++] = eyeLheightDefault;
+  s[i++] = eyeRwidthCurrent; s[i++] = eyeRwidthNext;
+  s[i++] = eyeRheightCurrent; s[i++] = eyeRheightNext; s[i++] = eyeRheightDefault;
+  s[i++] = eyeLborderRadiusCurrent; s[i++] = eyeLborderRadiusNext;
+  s[i++] = eyeRborderRadiusCurrent; s[i++] = eyeRborderRadiusNext;
+  s[i++] = eyeLx; s[i++] = eyeLy; s[i++] = eyeLxNext; s[i++] = eyeLyNext;
+  s[i++] = eyeRx; s[i++] = eyeRy; s[i++] = eyeRxNext; s[i++] = eyeRyNext;
+  s[i++] = spaceBetweenCurrent; s[i++] = spaceBetweenNext;
+  s[i++] = eyeLheightOffset; s[i++] = eyeRheightOffset; // set by the caller with external tweening
+  s[i++] = eyelidsTiredHeight; s[i++] = eyelidsTiredHeightNext;
+  s[i++] = eyelidsSleepyHeight; s[i++] = eyelidsSleepyHeightNext;
+  s[i++] = eyelidsAngryHeight; s[i++] = eyelidsAngryHeightNext;
+  s[i++] = eyelidsHappyBottomOffset; s[i++] = eyelidsHappyBottomOffsetNext;
+  s[i++] = (mainColor << 8) | bgColor;
+  s[i++] = tired | (sleepy << 1) | (angry << 2) | (happy << 3) | (curious << 4) |
+           (cyclops << 5) | (eyeL_open << 6) | (eyeR_open << 7) | (hFlicker << 8) |
+           (vFlicker << 9) | (sweat << 10) | (laugh << 11) | (confused << 12) |
+           (autoFlush << 13) | (tweenExternally << 14);
+}
 
 
 }; // end of class roboEyes
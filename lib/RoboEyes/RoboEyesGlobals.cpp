@@ -1,4 +0,0 @@
-#include <Arduino.h>
-#define ROBOEYES_COLORS_DEFINED
-uint8_t BGCOLOR = 0;
-uint8_t MAINCOLOR = 1;
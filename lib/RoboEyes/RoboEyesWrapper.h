@@ -8,16 +8,12 @@
 #include <Adafruit_SSD1306.h>
 
 // Guardia para evitar conflictos de macros con RoboEyes
-#pragma push_macro("BGCOLOR")
-#pragma push_macro("MAINCOLOR")
 #pragma push_macro("DEFAULT")
 #pragma push_macro("TIRED")
 #pragma push_macro("ANGRY")
 #pragma push_macro("HAPPY")
 #pragma push_macro("ON")
 #pragma push_macro("OFF")
-#undef BGCOLOR
-#undef MAINCOLOR
 #undef DEFAULT
 #undef TIRED
 #undef ANGRY
@@ -33,7 +29,5 @@
 #pragma pop_macro("ANGRY")
 #pragma pop_macro("TIRED")
 #pragma pop_macro("DEFAULT")
-#pragma pop_macro("MAINCOLOR")
-#pragma pop_macro("BGCOLOR")
 
 #endif
@@ -0,0 +1,201 @@
+#include "audio.h"
+
+// La cola se comparte entre loop() (play/stop) y el temporizador (step)
+#ifdef ARDUINO_ARCH_ESP32
+#define AUDIO_LOCK() portENTER_CRITICAL(&lock)
+#define AUDIO_UNLOCK() portEXIT_CRITICAL(&lock)
+#else
+#define AUDIO_LOCK() ((void)0)
+#define AUDIO_UNLOCK() ((void)0)
+#endif
+
+AudioEngine::AudioEngine() {
+  head = 0;
+  count = 0;
+  current = { 0, 0, 0 };
+  currentPriority = 0;
+  phase = AUDIO_IDLE;
+  restart = false;
+  stepAt = 0;
+  pin = 0;
+  enabled = true;
+  started = false;
+  notesPlayed = 0;
+  preemptions = 0;
+  dropped = 0;
+#ifdef ARDUINO_ARCH_ESP32
+  timer = nullptr;
+  portMUX_INITIALIZE(&lock);
+#endif
+}
+
+bool AudioEngine::begin(uint8_t buzzerPin) {
+  pin = buzzerPin;
+
+#ifdef ARDUINO_ARCH_ESP32
+#if ESP_ARDUINO_VERSION_MAJOR >= 3
+  if (!ledcAttach(pin, 1000, AUDIO_LEDC_RESOLUTION)) return false;
+#else
+  ledcSetup(AUDIO_LEDC_CHANNEL, 1000, AUDIO_LEDC_RESOLUTION);
+  ledcAttachPin(pin, AUDIO_LEDC_CHANNEL);
+#endif
+
+  // El callback corre en la tarea de esp_timer, no en una ISR: puede
+  // reconfigurar el LEDC
+  esp_timer_create_args_t args = {};
+  args.callback = timerEntry;
+  args.arg = this;
+  args.dispatch_method = ESP_TIMER_TASK;
+  args.name = "audio";
+  if (esp_timer_create(&args, &timer) != ESP_OK) return false;
+#endif
+
+  output(0);
+  started = true;
+  return true;
+}
+
+void AudioEngine::setEnabled(bool on) {
+  enabled = on;
+  if (!on) stop();
+}
+
+uint8_t AudioEngine::highestPriority() const {
+  uint8_t highest = (phase != AUDIO_IDLE) ? currentPriority : 0;
+  for (uint8_t i = 0; i < count; i++) {
+    uint8_t priority = priorities[(head + i) % AUDIO_QUEUE_SIZE];
+    if (priority > highest) highest = priority;
+  }
+  return highest;
+}
+
+bool AudioEngine::play(const AudioNote* notes, uint8_t noteCount, AudioPriority priority) {
+  if (!enabled || !started || noteCount == 0) return false;
+  if (noteCount > AUDIO_QUEUE_SIZE) {
+    dropped++;
+    return false;
+  }
+
+  AUDIO_LOCK();
+  bool busy = (phase != AUDIO_IDLE || count > 0);
+  bool preempt = busy && priority > highestPriority();
+  if (preempt) {
+    // Lo que suena y lo que espera tiene menos prioridad: se descarta
+    head = 0;
+    count = 0;
+    restart = true;
+    preemptions++;
+  }
+  if (count + noteCount > AUDIO_QUEUE_SIZE) {
+    dropped++;
+    AUDIO_UNLOCK();
+    return false;
+  }
+  for (uint8_t i = 0; i < noteCount; i++) {
+    uint8_t slot = (head + count) % AUDIO_QUEUE_SIZE;
+    queue[slot] = notes[i];
+    priorities[slot] = priority;
+    count++;
+  }
+  AUDIO_UNLOCK();
+
+  if (!busy || preempt) kick();
+  return true;
+}
+
+bool AudioEngine::playTone(uint16_t frequency, uint16_t duration, AudioPriority priority, uint16_t gap) {
+  AudioNote note = { frequency, duration, gap };
+  return play(&note, 1, priority);
+}
+
+void AudioEngine::stop() {
+  if (!started) return;
+  AUDIO_LOCK();
+  head = 0;
+  count = 0;
+  phase = AUDIO_IDLE;
+  restart = false;
+  AUDIO_UNLOCK();
+#ifdef ARDUINO_ARCH_ESP32
+  esp_timer_stop(timer);
+#endif
+  output(0);
+}
+
+bool AudioEngine::isPlaying() {
+  // En el ESP32 play() solo encola y arma el temporizador: hasta que salta,
+  // phase sigue en AUDIO_IDLE con notas esperando
+  AUDIO_LOCK();
+  bool busy = (phase != AUDIO_IDLE || count > 0);
+  AUDIO_UNLOCK();
+  return busy;
+}
+
+uint16_t AudioEngine::step() {
+  uint16_t frequency = 0;
+  uint16_t wait = 0;
+
+  AUDIO_LOCK();
+  if (phase == AUDIO_NOTE && current.gap > 0 && !restart) {
+    // Silencio tras la nota
+    phase = AUDIO_GAP;
+    wait = current.gap;
+  } else if (count > 0) {
+    current = queue[head];
+    currentPriority = priorities[head];
+    head = (head + 1) % AUDIO_QUEUE_SIZE;
+    count--;
+    phase = AUDIO_NOTE;
+    frequency = current.frequency;
+    wait = max(current.duration, (uint16_t)1);
+    notesPlayed++;
+  } else {
+    phase = AUDIO_IDLE;
+  }
+  restart = false;
+  AUDIO_UNLOCK();
+
+  output(frequency);
+  return wait;
+}
+
+void AudioEngine::output(uint16_t frequency) {
+#ifdef ARDUINO_ARCH_ESP32
+  // Frecuencia 0 deja el duty a 0: el buzzer calla
+#if ESP_ARDUINO_VERSION_MAJOR >= 3
+  ledcWriteTone(pin, frequency);
+#else
+  ledcWriteTone(AUDIO_LEDC_CHANNEL, frequency);
+#endif
+#else
+  if (frequency > 0) tone(pin, frequency);
+  else noTone(pin);
+#endif
+}
+
+#ifdef ARDUINO_ARCH_ESP32
+void AudioEngine::timerEntry(void* arg) {
+  AudioEngine* self = static_cast<AudioEngine*>(arg);
+  uint16_t wait = self->step();
+  if (wait > 0) esp_timer_start_once(self->timer, (uint64_t)wait * 1000ULL);
+}
+
+void AudioEngine::kick() {
+  // Reprogramar el temporizador para que la primera nota empiece ya; si el
+  // callback se ha adelantado, restart hace que salte a la cola nueva
+  esp_timer_stop(timer);
+  esp_timer_start_once(timer, 1);
+}
+
+void AudioEngine::update(unsigned long now) {
+}
+#else
+void AudioEngine::kick() {
+  stepAt = millis() + step();
+}
+
+void AudioEngine::update(unsigned long now) {
+  if (phase == AUDIO_IDLE || (long)(now - stepAt) < 0) return;
+  stepAt = now + step();
+}
+#endif
@@ -0,0 +1,263 @@
+#include "benchmark.h"
+
+#ifdef RENDER_BENCHMARK
+
+// ==================== ESCENARIOS ====================
+// Las pantallas estáticas invalidan la caché en cada frame para medir el
+// coste real de rasterizarlas, no el de un acierto de caché
+
+const RenderBenchmark::Scenario RenderBenchmark::scenarios[] = {
+  { "main",          nullptr,            renderMain,              true  },
+  { "eyes_default",  setupEyesDefault,   renderEyesMood,          false },
+  { "eyes_tired",    setupEyesTired,     renderEyesMood,          false },
+  { "eyes_angry",    setupEyesAngry,     renderEyesMood,          false },
+  { "eyes_happy",    setupEyesHappy,     renderEyesMood,          false },
+  { "sleep",         nullptr,            renderSleep,             false },
+  { "no_coins",      nullptr,            renderInsufficientCoins, false },
+  { "menu",          nullptr,            renderMenu,              false },
+  { "shop_menu",     nullptr,            renderShopMenu,          false },
+  { "game_menu",     nullptr,            renderGameMenu,          false },
+  { "dodge",         setupDodge,         renderDodge,             false },
+  { "dodge_over",    setupDodge,         renderDodgeOver,         false },
+  { "memory_show",   setupMemoryShowing, renderMemory,            false },
+  { "memory_input",  setupMemoryInput,   renderMemory,            false },
+  { "memory_over",   setupMemoryInput,   renderMemoryOver,        false },
+  { "tictactoe",     setupTicTacToe,     renderTicTacToe,         false },
+  { "tictactoe_over", setupTicTacToeOver, renderTicTacToeOver,    false },
+  { nullptr,         nullptr,            nullptr,                 false }
+};
+
+// Media por frame en ns. En 64 bits: con unsigned long (32 bits en el
+// ESP32) micros * 1000 se desborda en cuanto el total pasa de ~4,3 s, es
+// decir con un flush medio de más de ~43 ms en BENCH_FRAMES frames
+static unsigned long nanosPerFrame(unsigned long micros, int frames) {
+  return (unsigned long)((unsigned long long)micros * 1000ULL / frames);
+}
+
+RenderBenchmark::RenderBenchmark(OledDisplay* disp, DisplayManager* mgr, ManualClock* clk) {
+  display = disp;
+  displayMgr = mgr;
+  clock = clk;
+  option = 0;
+}
+
+void RenderBenchmark::run(Print* out, int frames) {
+  out->printf("\n=== Render benchmark (%d frames/pantalla) ===\n", frames);
+  out->printf("%-15s %9s %9s %7s %6s %5s %5s %4s %4s %4s %4s %4s %4s %6s %6s\n",
+              "pantalla", "render_ns", "flush_ns", "pixels", "pxcall", "hline", "vline",
+              "rect", "line", "rrct", "tri", "char", "blit", "B_ini", "B/fr");
+  
+  for (const Scenario* s = scenarios; s->name != nullptr; s++) {
+    runScenario(*s, out, frames);
+  }
+  
+  // Dejar la pantalla como estaba antes del benchmark
+  displayMgr->invalidateScreenCache();
+  display->invalidate();
+}
+
+void RenderBenchmark::runScenario(const Scenario& scenario, Print* out, int frames) {
+  option = 0;
+  if (scenario.setup != nullptr) scenario.setup(this);
+  
+  // Partir de la pantalla en negro para que el primer frame sea una transición completa
+  display->clearDisplay();
+  display->display();
+  display->waitForFlush();
+  display->resetStats();
+  displayMgr->invalidateScreenCache();
+  
+  // Primer frame: bytes de la transición desde una pantalla vacía
+  scenario.render(this);
+  displayMgr->commitFrame();
+  display->waitForFlush();
+  unsigned long firstBytes = display->getBytesSent() + display->getCommandBytesSent();
+  
+  display->resetStats();
+  display->resetRenderStats();
+  unsigned long renderMicros = 0;
+  unsigned long flushMicros = 0;
+  
+  for (int i = 0; i < frames; i++) {
+    if (scenario.animated) {
+      // Con reloj manual la animación es la misma en cada ejecución
+      if (clock != nullptr) clock->advance(BENCH_FRAME_PERIOD);
+      else delay(BENCH_FRAME_PERIOD);
+    }
+    
+    unsigned long t0 = micros();
+    scenario.render(this);
+    unsigned long t1 = micros();
+    displayMgr->commitFrame();
+    display->waitForFlush();
+    unsigned long t2 = micros();
+    
+    renderMicros += t1 - t0;
+    flushMicros += t2 - t1;
+  }
+  
+  const RenderStats& st = display->getRenderStats();
+  unsigned long bytes = display->getBytesSent() + display->getCommandBytesSent();
+  out->printf("%-15s %9lu %9lu %7lu %6lu %5lu %5lu %4lu %4lu %4lu %4lu %4lu %4lu %6lu %6lu\n",
+              scenario.name,
+              nanosPerFrame(renderMicros, frames), nanosPerFrame(flushMicros, frames),
+              st.pixels / frames, st.pixelCalls / frames, st.hLines / frames, st.vLines / frames,
+              st.rects / frames, st.lines / frames, st.roundRects / frames, st.triangles / frames,
+              st.chars / frames, st.blits / frames, firstBytes, bytes / frames);
+}
+
+// ==================== ESTADO REPRESENTATIVO ====================
+
+void RenderBenchmark::prepareDodge() {
+  dodge.reset();
+  dodge.level = 3;
+  dodge.record = 7;
+  dodge.score = 120;
+  // Tres cajas repartidas por los dos carriles jugables
+  const float xs[] = { 30, 70, 110 };
+  for (int i = 0; i < 3; i++) {
+    dodge.obstacles[i].x = xs[i];
+    dodge.obstacles[i].lane = 1 + (i % 2);
+    dodge.obstacles[i].active = true;
+  }
+  dodge.obstacleCount = 3;
+  dodge.maxActiveObstacles = 3;
+}
+
+void RenderBenchmark::prepareTicTacToe(GameResult result) {
+  ticTacToe.reset();
+  // Partida a medias: 3 fichas de cada uno y el cursor en una celda libre
+  const int layout[3][3] = {
+    { CELL_PLAYER, CELL_TAMAGOTCHI, CELL_EMPTY },
+    { CELL_EMPTY, CELL_PLAYER, CELL_TAMAGOTCHI },
+    { CELL_TAMAGOTCHI, CELL_EMPTY, CELL_PLAYER }
+  };
+  memcpy(ticTacToe.board, layout, sizeof(layout));
+  ticTacToe.movesCount = 6;
+  ticTacToe.cursorX = 2;
+  ticTacToe.cursorY = 0;
+  ticTacToe.wins = 4;
+  ticTacToe.draws = 2;
+  ticTacToe.losses = 3;
+  ticTacToe.result = result;
+  ticTacToe.state = (result == RESULT_NONE) ? TIC_PLAYER_TURN : TIC_GAME_OVER;
+}
+
+// ==================== RENDER ====================
+
+void RenderBenchmark::renderMain(RenderBenchmark* bench) {
+  bench->displayMgr->showMainScreen();
+}
+
+// Ojos redibujados completos en cada frame con un mood fijo (option es el
+// mood de Tamagotchi::getMood): los párpados no deben encarecer el frame
+void RenderBenchmark::settleEyes(int mood) {
+  option = mood;
+  displayMgr->showEyesMood(mood);
+  // Se mide el mood ya alcanzado, no el fundido
+  if (clock != nullptr) clock->advance(EYE_MOOD_BLEND_MS);
+  else delay(EYE_MOOD_BLEND_MS);
+}
+
+void RenderBenchmark::setupEyesDefault(RenderBenchmark* bench) {
+  bench->settleEyes(0);
+}
+
+void RenderBenchmark::setupEyesTired(RenderBenchmark* bench) {
+  bench->settleEyes(5);
+}
+
+void RenderBenchmark::setupEyesAngry(RenderBenchmark* bench) {
+  bench->settleEyes(2);
+}
+
+void RenderBenchmark::setupEyesHappy(RenderBenchmark* bench) {
+  bench->settleEyes(3);
+}
+
+void RenderBenchmark::renderEyesMood(RenderBenchmark* bench) {
+  bench->displayMgr->invalidateScreenCache();
+  bench->displayMgr->showEyesMood(bench->option);
+}
+
+void RenderBenchmark::renderSleep(RenderBenchmark* bench) {
+  bench->displayMgr->invalidateScreenCache();
+  bench->displayMgr->showSleepScreen();
+}
+
+void RenderBenchmark::renderInsufficientCoins(RenderBenchmark* bench) {
+  bench->displayMgr->invalidateScreenCache();
+  bench->displayMgr->showInsufficientCoinsScreen();
+}
+
+void RenderBenchmark::renderMenu(RenderBenchmark* bench) {
+  bench->displayMgr->invalidateScreenCache();
+  bench->displayMgr->showMenuScreen(bench->option++ % 4, true);
+}
+
+void RenderBenchmark::renderShopMenu(RenderBenchmark* bench) {
+  bench->displayMgr->invalidateScreenCache();
+  bench->displayMgr->showShopMenuScreen(bench->option++ % 6);
+}
+
+void RenderBenchmark::renderGameMenu(RenderBenchmark* bench) {
+  bench->displayMgr->invalidateScreenCache();
+  bench->displayMgr->showGameMenuScreen(bench->option++ % 3);
+}
+
+void RenderBenchmark::setupDodge(RenderBenchmark* bench) {
+  bench->prepareDodge();
+}
+
+void RenderBenchmark::renderDodge(RenderBenchmark* bench) {
+  // Avanza las cajas una posición por frame sin depender de millis()
+  for (int i = 0; i < MAX_OBSTACLES; i++) {
+    Obstacle& obs = bench->dodge.obstacles[i];
+    if (!obs.active) continue;
+    obs.x -= bench->dodge.obstacleSpeed;
+    if (obs.x < -10) obs.x = GAME_WIDTH;
+  }
+  bench->displayMgr->showGameScreen(&bench->dodge);
+}
+
+void RenderBenchmark::renderDodgeOver(RenderBenchmark* bench) {
+  bench->displayMgr->showGameOver(&bench->dodge, bench->dodge.getScore() / 10);
+}
+
+void RenderBenchmark::setupMemoryShowing(RenderBenchmark* bench) {
+  bench->memory.reset();
+  bench->memory.startShowingSequence();
+}
+
+void RenderBenchmark::setupMemoryInput(RenderBenchmark* bench) {
+  bench->memory.reset();
+  bench->memory.startWaitingInput();
+}
+
+void RenderBenchmark::renderMemory(RenderBenchmark* bench) {
+  bench->displayMgr->showMemoryGameScreen(&bench->memory);
+}
+
+void RenderBenchmark::renderMemoryOver(RenderBenchmark* bench) {
+  bench->displayMgr->showMemoryGameOver(&bench->memory, 12);
+}
+
+void RenderBenchmark::setupTicTacToe(RenderBenchmark* bench) {
+  bench->prepareTicTacToe(RESULT_NONE);
+}
+
+void RenderBenchmark::setupTicTacToeOver(RenderBenchmark* bench) {
+  bench->prepareTicTacToe(RESULT_PLAYER_WIN);
+}
+
+void RenderBenchmark::renderTicTacToe(RenderBenchmark* bench) {
+  // El cursor recorre las celdas libres como si el jugador lo moviera
+  bench->ticTacToe.moveCursor();
+  bench->displayMgr->showTicTacToeScreen(&bench->ticTacToe);
+}
+
+void RenderBenchmark::renderTicTacToeOver(RenderBenchmark* bench) {
+  bench->displayMgr->showTicTacToeGameOver(&bench->ticTacToe, 30);
+}
+
+#endif
@@ -0,0 +1,12 @@
+#include "clock.h"
+
+SystemClock systemClock;
+SystemRng systemRng;
+
+long SeededRng::next(long max) {
+  state ^= state << 13;
+  state ^= state >> 17;
+  state ^= state << 5;
+  if (max <= 0) return 0;
+  return (long)(state % (uint32_t)max);
+}
@@ -1,18 +1,20 @@
 #include "display.h"
 
 void DisplayManager::showShopMenuScreen(int shopMenuOption) {
+  uint32_t key = mixKey(SCREEN_SHOP_MENU, shopMenuOption);
+  key = mixKey(key, pet->getCoins());
+  key = mixKey(key, pet->getMemoryGameUnlocked());
+  key = mixKey(key, pet->getTicTacToeUnlocked());
+  if (isScreenCached(key)) return;
+  
   display->clearDisplay();
   // Mostrar monedas arriba
-  display->setTextSize(1);
-  display->setTextColor(SSD1306_WHITE);
-  display->setCursor(0, 0);
-  display->print("Monedas: ");
-  display->print(pet->getCoins());
+  drawLabelValue(LABEL_MONEDAS_PREFIX, 0, 0, pet->getCoins());
   // Línea divisoria
   display->drawLine(0, 10, 127, 10, SSD1306_WHITE);
 
   // Artículos de la tienda
-  const char* labels[6] = {"Manzana (10c/+25H)", "Pan (15c/+50H)", "Queso (20c/+75H)", "Tarta (25c/+100H)", "Juego Memoria (100c)", "3 en Raya (100c)"};
+  const TextLabel labels[6] = {LABEL_SHOP_MANZANA, LABEL_SHOP_PAN, LABEL_SHOP_QUESO, LABEL_SHOP_TARTA, LABEL_SHOP_MEMORIA, LABEL_SHOP_TRES_EN_RAYA};
   
   // Contar items disponibles
   int totalItems = 4; // Siempre hay 4 comidas
@@ -29,19 +31,16 @@ void DisplayManager::showShopMenuScreen(int shopMenuOption) {
     if (i == 4 && pet->getMemoryGameUnlocked()) continue;
     if (i == 5 && pet->getTicTacToeUnlocked()) continue;
     
+    uint16_t color = SSD1306_WHITE;
     if (currentIdx == shopMenuOption) {
       display->fillRect(0, y + (currentIdx * itemHeight), 128, itemHeight, SSD1306_WHITE);
-      display->setTextColor(SSD1306_BLACK);
-    } else {
-      display->setTextColor(SSD1306_WHITE);
+      color = SSD1306_BLACK;
     }
-    display->setCursor(2, y + (currentIdx * itemHeight) + 1);
-    display->setTextSize(1);
-    display->print(labels[i]);
+    drawLabel(labels[i], 2, y + (currentIdx * itemHeight) + 1, color);
     
     currentIdx++;
   }
-  display->display();
+  frameDirty = true;
 }
 #include "display.h"
 
@@ -49,16 +48,84 @@ DisplayManager::DisplayManager() {
   display = nullptr;
   pet = nullptr;
   currentMood = 0;
+  frameDirty = false;
+  renderedScreenKey = 0;
+  sleepFrame = false;
+  panelDimmed = false;
+  deferredFrames = 0;
 }
 
-void DisplayManager::initialize(Adafruit_SSD1306* disp, Tamagotchi* p) {
+void DisplayManager::initialize(OledDisplay* disp, Tamagotchi* p, Clock* clock, Rng* rng) {
   display = disp;
   pet = p;
-  eyesManager.initialize(disp);
+  eyesManager.initialize(disp, clock, rng);
   currentMood = 0;
+  frameDirty = false;
+  renderedScreenKey = 0;
+  sleepFrame = false;
+  panelDimmed = false;
+  deferredFrames = 0;
+}
+
+void DisplayManager::commitFrame() {
+  // Contraste mínimo mientras se muestra la pantalla de sueño
+  if (SLEEP_DIM_PANEL && sleepFrame != panelDimmed) {
+    display->dim(sleepFrame);
+    panelDimmed = sleepFrame;
+  }
+  sleepFrame = false;
+  
+  // Único punto del frame que envía el buffer al panel
+  if (!frameDirty) return;
+  // Con el frame anterior aún en el bus no se espera: este sigue en el
+  // buffer (frameDirty) y sale en el tick siguiente con lo que se añada
+  if (display->isFlushing()) {
+    deferredFrames++;
+    return;
+  }
+  display->display();
+  frameDirty = false;
+}
+
+void DisplayManager::invalidateScreenCache() {
+  renderedScreenKey = 0;
+}
+
+uint32_t DisplayManager::mixKey(uint32_t key, int32_t value) {
+  // FNV-1a sobre los 4 bytes del valor
+  for (int i = 0; i < 4; i++) {
+    key ^= (uint8_t)(value >> (i * 8));
+    key *= 16777619UL;
+  }
+  return key;
+}
+
+bool DisplayManager::isScreenCached(uint32_t key) {
+  if (key == renderedScreenKey) return true;
+  renderedScreenKey = key;
+  return false;
+}
+
+void DisplayManager::drawLabel(TextLabel label, int16_t x, int16_t y, uint16_t color) {
+  textAtlas.draw(display, label, x, y, color);
+}
+
+void DisplayManager::drawLabelValue(TextLabel label, int16_t x, int16_t y, int value) {
+  // Prefijo fijo desde el atlas, número dinámico con la fuente de GFX
+  textAtlas.draw(display, label, x, y, SSD1306_WHITE);
+  display->setTextSize(1);
+  display->setTextColor(SSD1306_WHITE);
+  display->setCursor(x + textAtlas.getWidth(label), y);
+  display->print(value);
 }
 
 void DisplayManager::showMainScreen() {
+  // Pantalla dinámica: la clave solo indica que el buffer contiene los ojos,
+  // y si no es así RoboEyes no puede saltarse el frame aunque esté en reposo
+  uint32_t key = mixKey(SCREEN_MAIN, 0);
+  bool bufferLost = (renderedScreenKey != key);
+  renderedScreenKey = key;
+  
   // Sincronizar mood con el estado del pet
   int newMood = pet->getMood();
   if (newMood != currentMood) {
@@ -67,55 +134,36 @@ void DisplayManager::showMainScreen() {
   }
   
   // Solo dibujar los ojos - sin overlays
-  drawEyesAnimated();
-  display->display();
+  drawEyesAnimated(bufferLost);
 }
 
 void DisplayManager::showSleepScreen() {
+  sleepFrame = true;
+  // Se dibuja una sola vez; mientras dura el sueño el panel conserva la imagen
+  if (isScreenCached(mixKey(SCREEN_SLEEP, 0))) return;
+  
   display->clearDisplay();
-  display->setTextSize(2);
-  display->setTextColor(SSD1306_WHITE);
   
   // Calcular posición centrada para "ZZZ..."
-  const char* text = "ZZZ...";
-  int16_t x1, y1;
-  uint16_t w, h;
-  display->getTextBounds(text, 0, 0, &x1, &y1, &w, &h);
-  
-  int x = (128 - w) / 2;
-  int y = (64 - h) / 2;
-  
-  display->setCursor(x, y);
-  display->print(text);
-  display->display();
+  int x = (128 - textAtlas.getWidth(LABEL_ZZZ)) / 2;
+  int y = (64 - textAtlas.getHeight(LABEL_ZZZ)) / 2;
+  drawLabel(LABEL_ZZZ, x, y);
+  frameDirty = true;
 }
 
 void DisplayManager::showInsufficientCoinsScreen() {
+  if (isScreenCached(mixKey(SCREEN_INSUFFICIENT_COINS, 0))) return;
+  
   display->clearDisplay();
-  display->setTextSize(1);
-  display->setTextColor(SSD1306_WHITE);
   
   // Calcular posición centrada para "Monedas insuficientes"
-  const char* text = "Monedas";
-  const char* text2 = "insuficientes";
-  int16_t x1, y1;
-  uint16_t w, h;
-  
   // Línea 1: "Monedas"
-  display->getTextBounds(text, 0, 0, &x1, &y1, &w, &h);
-  int x = (128 - w) / 2;
-  int y = 24;
-  display->setCursor(x, y);
-  display->print(text);
+  drawLabel(LABEL_MONEDAS, (128 - textAtlas.getWidth(LABEL_MONEDAS)) / 2, 24);
   
   // Línea 2: "insuficientes"
-  display->getTextBounds(text2, 0, 0, &x1, &y1, &w, &h);
-  x = (128 - w) / 2;
-  y = 36;
-  display->setCursor(x, y);
-  display->print(text2);
+  drawLabel(LABEL_INSUFICIENTES, (128 - textAtlas.getWidth(LABEL_INSUFICIENTES)) / 2, 36);
   
-  display->display();
+  frameDirty = true;
 }
 
 void DisplayManager::drawMenu(int selectedOption) {
@@ -143,6 +191,13 @@ void DisplayManager::drawMenu(int selectedOption) {
 }
 
 void DisplayManager::showMenuScreen(int selectedOption, bool soundEnabled) {
+  uint32_t key = mixKey(SCREEN_MENU, selectedOption);
+  key = mixKey(key, soundEnabled);
+  key = mixKey(key, pet->getHunger());
+  key = mixKey(key, pet->getBoredom());
+  key = mixKey(key, pet->getSleepiness());
+  if (isScreenCached(key)) return;
+  
   display->clearDisplay();
   
   // Mostrar estadísticas arriba
@@ -170,32 +225,25 @@ void DisplayManager::showMenuScreen(int selectedOption, bool soundEnabled) {
   int y = 15;
   int itemHeight = 12;
   
-  const char* labels[] = {"TIENDA", "JUGAR", "DORMIR", ""};
+  // Opción SOUND con estado
+  const TextLabel labels[] = {LABEL_TIENDA, LABEL_JUGAR, LABEL_DORMIR,
+                              soundEnabled ? LABEL_SOUND_ON : LABEL_SOUND_OFF};
   
   for(int i = 0; i < 4; i++) {
+    uint16_t color = SSD1306_WHITE;
     if(i == selectedOption) {
       display->fillRect(0, y + (i * itemHeight), 128, itemHeight, SSD1306_WHITE);
-      display->setTextColor(SSD1306_BLACK);
-    } else {
-      display->setTextColor(SSD1306_WHITE);
+      color = SSD1306_BLACK;
     }
     
-    display->setCursor(10, y + (i * itemHeight) + 2);
-    display->setTextSize(1);
-    
-    if (i == 3) {
-      // Opción SOUND con estado
-      display->print("SOUND: ");
-      display->print(soundEnabled ? "ON" : "OFF");
-    } else {
-      display->print(labels[i]);
-    }
+    drawLabel(labels[i], 10, y + (i * itemHeight) + 2, color);
   }
   
-  display->display();
+  frameDirty = true;
 }
 
 void DisplayManager::showGameScreen(DodgeGame* game) {
+  renderedScreenKey = 0;
   display->clearDisplay();
   
   drawLanes(game);
@@ -203,39 +251,30 @@ void DisplayManager::showGameScreen(DodgeGame* game) {
   drawObstacles(game);
   
   // Nivel en la izquierda
-  display->setTextSize(1);
-  display->setTextColor(SSD1306_WHITE);
-  display->setCursor(0, 0);
-  display->print("Lvl: ");
-  display->print(game->getLevel());
+  drawLabelValue(LABEL_LVL_PREFIX, 0, 0, game->getLevel());
   
   // Récord en la derecha
-  display->setCursor(80, 0);
-  display->print("RCRD:");
-  display->print(game->getRecord());
+  drawLabelValue(LABEL_RCRD_PREFIX, 80, 0, game->getRecord());
   
-  display->display();
+  frameDirty = true;
 }
 
 void DisplayManager::showGameOver(DodgeGame* game, int coinsEarned) {
+  renderedScreenKey = 0;
   display->clearDisplay();
   
-  display->setTextSize(2);
-  display->setTextColor(SSD1306_WHITE);
-  display->setCursor(20, 10);
-  display->println("GAME OVER");
+  drawLabel(LABEL_GAME_OVER, 20, 10);
   
-  display->setTextSize(1);
-  display->setCursor(10, 45);
-  display->print("Coins: +");
-  display->println(coinsEarned);
+  drawLabelValue(LABEL_COINS_PREFIX, 10, 45, coinsEarned);
   
-  display->display();
+  frameDirty = true;
 }
 
-void DisplayManager::drawEyesAnimated() {
-  // Los ojos se dibujan a través de eyesManager
-  eyesManager.drawEyesAnimated();
+void DisplayManager::drawEyesAnimated(bool bufferLost) {
+  // Los ojos se dibujan a través de eyesManager; en reposo no hay nada que enviar
+  if (eyesManager.drawEyesAnimated(bufferLost)) {
+    frameDirty = true;
+  }
 }
 
 void DisplayManager::drawHungerIcon() {
@@ -320,12 +359,14 @@ void DisplayManager::drawGameMenu(int selectedOption) {
 }
 
 void DisplayManager::showGameMenuScreen(int selectedOption) {
+  uint32_t key = mixKey(SCREEN_GAME_MENU, selectedOption);
+  key = mixKey(key, pet->getMemoryGameUnlocked());
+  key = mixKey(key, pet->getTicTacToeUnlocked());
+  if (isScreenCached(key)) return;
+  
   display->clearDisplay();
   // Título
-  display->setTextSize(1);
-  display->setTextColor(SSD1306_WHITE);
-  display->setCursor(25, 5);
-  display->print("ELIGE UN JUEGO");
+  drawLabel(LABEL_ELIGE_UN_JUEGO, 25, 5);
   // Línea divisoria
   display->drawLine(0, 15, 127, 15, SSD1306_WHITE);
   // Opciones
@@ -334,49 +375,41 @@ void DisplayManager::showGameMenuScreen(int selectedOption) {
   int idx = 0;
   
   // Siempre mostrar ESQUIVAR
+  uint16_t color = SSD1306_WHITE;
   if (selectedOption == idx) {
     display->fillRect(0, y + (idx * itemHeight), 128, itemHeight, SSD1306_WHITE);
-    display->setTextColor(SSD1306_BLACK);
-  } else {
-    display->setTextColor(SSD1306_WHITE);
+    color = SSD1306_BLACK;
   }
-  display->setCursor(20, y + (idx * itemHeight) + 3);
-  display->setTextSize(1);
-  display->print("ESQUIVAR");
+  drawLabel(LABEL_ESQUIVAR, 20, y + (idx * itemHeight) + 3, color);
   idx++;
   
   // Mostrar MEMORIA si está desbloqueado
   if (pet->getMemoryGameUnlocked()) {
+    color = SSD1306_WHITE;
     if (selectedOption == idx) {
       display->fillRect(0, y + (idx * itemHeight), 128, itemHeight, SSD1306_WHITE);
-      display->setTextColor(SSD1306_BLACK);
-    } else {
-      display->setTextColor(SSD1306_WHITE);
+      color = SSD1306_BLACK;
     }
-    display->setCursor(20, y + (idx * itemHeight) + 3);
-    display->setTextSize(1);
-    display->print("MEMORIA");
+    drawLabel(LABEL_MEMORIA, 20, y + (idx * itemHeight) + 3, color);
     idx++;
   }
   
   // Mostrar TRES EN RAYA si está desbloqueado
   if (pet->getTicTacToeUnlocked()) {
+    color = SSD1306_WHITE;
     if (selectedOption == idx) {
       display->fillRect(0, y + (idx * itemHeight), 128, itemHeight, SSD1306_WHITE);
-      display->setTextColor(SSD1306_BLACK);
-    } else {
-      display->setTextColor(SSD1306_WHITE);
+      color = SSD1306_BLACK;
     }
-    display->setCursor(20, y + (idx * itemHeight) + 3);
-    display->setTextSize(1);
-    display->print("TRES EN RAYA");
+    drawLabel(LABEL_TRES_EN_RAYA, 20, y + (idx * itemHeight) + 3, color);
     idx++;
   }
   
-  display->display();
+  frameDirty = true;
 }
 
 void DisplayManager::showMemoryGameScreen(MemoryGame* memGame) {
+  renderedScreenKey = 0;
   display->clearDisplay();
   
   MemoryGameState state = memGame->getState();
@@ -384,31 +417,20 @@ void DisplayManager::showMemoryGameScreen(MemoryGame* memGame) {
   if (state == MGS_SHOWING_SEQUENCE) {
     // Durante la secuencia, solo se muestran los ojos y animaciones
     // (manejado en main.cpp)
-    display->setTextSize(2);
-    display->setTextColor(SSD1306_WHITE);
-    display->setCursor(15, 25);
-    display->print("Observa...");
+    drawLabel(LABEL_OBSERVA, 15, 25);
   } 
   else if (state == MGS_WAITING_INPUT) {
     // Pantalla "REPITE" con nivel y record
-    display->setTextSize(2);
-    display->setTextColor(SSD1306_WHITE);
-    display->setCursor(25, 10);
-    display->print("REPITE");
+    drawLabel(LABEL_REPITE, 25, 10);
     
     // Línea divisoria
     display->drawLine(0, 30, 127, 30, SSD1306_WHITE);
     
     // Mostrar nivel actual
-    display->setTextSize(1);
-    display->setCursor(10, 38);
-    display->print("Nivel: ");
-    display->print(memGame->getLevel());
+    drawLabelValue(LABEL_NIVEL_PREFIX, 10, 38, memGame->getLevel());
     
     // Mostrar record
-    display->setCursor(10, 50);
-    display->print("Record: ");
-    display->print(memGame->getHighScore());
+    drawLabelValue(LABEL_RECORD_PREFIX, 10, 50, memGame->getHighScore());
     
     // Indicador de progreso
     display->setCursor(85, 38);
@@ -420,44 +442,35 @@ void DisplayManager::showMemoryGameScreen(MemoryGame* memGame) {
     // Pantalla de game over (manejada por showMemoryGameOver)
   }
   
-  display->display();
+  frameDirty = true;
 }
 
 void DisplayManager::showMemoryGameOver(MemoryGame* memGame, int coinsEarned) {
+  renderedScreenKey = 0;
   display->clearDisplay();
   
-  display->setTextSize(2);
-  display->setTextColor(SSD1306_WHITE);
-  display->setCursor(10, 5);
-  display->println("GAME OVER");
-  
-  display->setTextSize(1);
-  display->setCursor(10, 30);
-  display->print("Nivel alcanzado: ");
-  display->println(memGame->getLevel());
-  
-  display->setCursor(10, 43);
-  display->print("Record: ");
-  display->println(memGame->getHighScore());
+  drawLabel(LABEL_GAME_OVER, 10, 5);
   
-  display->setCursor(10, 54);
-  display->print("Monedas: +");
-  display->println(coinsEarned);
+  drawLabelValue(LABEL_NIVEL_ALCANZADO_PREFIX, 10, 30, memGame->getLevel());
+  drawLabelValue(LABEL_RECORD_PREFIX, 10, 43, memGame->getHighScore());
+  drawLabelValue(LABEL_MONEDAS_PLUS_PREFIX, 10, 54, coinsEarned);
   
-  display->display();
+  frameDirty = true;
 }
 
 void DisplayManager::showEyesBlink() {
+  if (isScreenCached(mixKey(SCREEN_EYE_POSE, EYE_POSE_BLINK))) return;
   display->clearDisplay();
   // Dibujar ojos cerrados simples (líneas horizontales)
   // Ojo izquierdo
   display->drawLine(32, 32, 52, 32, SSD1306_WHITE);
   // Ojo derecho
   display->drawLine(76, 32, 96, 32, SSD1306_WHITE);
-  display->display();
+  frameDirty = true;
 }
 
 void DisplayManager::showEyesLookUp() {
+  if (isScreenCached(mixKey(SCREEN_EYE_POSE, EYE_POSE_LOOK_UP))) return;
   display->clearDisplay();
   // Dibujar ojos mirando arriba
   // Ojo izquierdo (círculo vacío con pupila arriba)
@@ -466,10 +479,11 @@ void DisplayManager::showEyesLookUp() {
   // Ojo derecho
   display->drawCircle(86, 28, 10, SSD1306_WHITE);
   display->fillCircle(86, 22, 4, SSD1306_WHITE);
-  display->display();
+  frameDirty = true;
 }
 
 void DisplayManager::showEyesNormal() {
+  if (isScreenCached(mixKey(SCREEN_EYE_POSE, EYE_POSE_NORMAL))) return;
   display->clearDisplay();
   // Dibujar ojos abiertos normales
   // Ojo izquierdo (círculo vacío con pupila centro)
@@ -478,10 +492,43 @@ void DisplayManager::showEyesNormal() {
   // Ojo derecho
   display->drawCircle(86, 32, 10, SSD1306_WHITE);
   display->fillCircle(86, 32, 4, SSD1306_WHITE);
-  display->display();
+  frameDirty = true;
+}
+
+void DisplayManager::showEyesPose(int pose) {
+  switch (pose) {
+    case EYE_POSE_BLINK: showEyesBlink(); break;
+    case EYE_POSE_LOOK_UP: showEyesLookUp(); break;
+    default: showEyesNormal(); break;
+  }
+}
+
+void DisplayManager::showEyesMood(int mood) {
+  // Como showMainScreen() pero con el mood de la secuencia; al volver a la
+  // pantalla principal se sincroniza de nuevo con el del pet
+  uint32_t key = mixKey(SCREEN_MAIN, 0);
+  bool bufferLost = (renderedScreenKey != key);
+  renderedScreenKey = key;
+  if (mood != currentMood) {
+    currentMood = mood;
+    eyesManager.setMood(mood);
+  }
+  drawEyesAnimated(bufferLost);
+}
+
+void DisplayManager::showCaption(TextLabel label) {
+  if (isScreenCached(mixKey(SCREEN_CAPTION, label))) return;
+  
+  display->clearDisplay();
+  int x = (128 - textAtlas.getWidth(label)) / 2;
+  int y = (64 - textAtlas.getHeight(label)) / 2;
+  drawLabel(label, x, y);
+  
+  frameDirty = true;
 }
 
 void DisplayManager::showTicTacToeScreen(TicTacToeGame* ticTacToe) {
+  renderedScreenKey = 0;
   display->clearDisplay();
   
   // Tamaño de cada celda
@@ -490,13 +537,10 @@ void DisplayManager::showTicTacToeScreen(TicTacToeGame* ticTacToe) {
   const int startY = 10;  // Dejar espacio arriba para info
   
   // Título: estado del juego
-  display->setTextSize(1);
-  display->setTextColor(SSD1306_WHITE);
-  display->setCursor(0, 0);
   if (ticTacToe->getState() == TIC_PLAYER_TURN) {
-    display->print("Tu turno");
+    drawLabel(LABEL_TU_TURNO, 0, 0);
   } else if (ticTacToe->getState() == TIC_TAMAGOTCHI_TURN) {
-    display->print("Pet juega...");
+    drawLabel(LABEL_PET_JUEGA, 0, 0);
   }
   
   // Dibujar la cuadrícula 3x3
@@ -546,35 +590,25 @@ void DisplayManager::showTicTacToeScreen(TicTacToeGame* ticTacToe) {
   display->print(" D:");
   display->print(ticTacToe->getLosses());
   
-  display->display();
+  frameDirty = true;
 }
 
 void DisplayManager::showTicTacToeGameOver(TicTacToeGame* ticTacToe, int coinsEarned) {
+  renderedScreenKey = 0;
   display->clearDisplay();
   
-  display->setTextSize(2);
-  display->setTextColor(SSD1306_WHITE);
-  
   GameResult result = ticTacToe->getResult();
   
   if (result == RESULT_PLAYER_WIN) {
-    display->setCursor(10, 10);
-    display->println("GANASTE!");
+    drawLabel(LABEL_GANASTE, 10, 10);
   } else if (result == RESULT_TAMAGOTCHI_WIN) {
-    display->setCursor(10, 10);
-    display->println("PERDISTE");
+    drawLabel(LABEL_PERDISTE, 10, 10);
   } else if (result == RESULT_DRAW) {
-    display->setCursor(20, 10);
-    display->println("EMPATE");
+    drawLabel(LABEL_EMPATE, 20, 10);
   }
   
-  display->setTextSize(1);
-  display->setCursor(10, 45);
-  display->print("Monedas: ");
-  if (coinsEarned >= 0) {
-    display->print("+");
-  }
-  display->println(coinsEarned);
+  drawLabelValue(coinsEarned >= 0 ? LABEL_MONEDAS_PLUS_PREFIX : LABEL_MONEDAS_PREFIX,
+                 10, 45, coinsEarned);
   
-  display->display();
+  frameDirty = true;
 }
@@ -1,185 +1,285 @@
 #include "eyes.h"
 
-EyesManager::EyesManager() {
+// Destino de cada mood (ver EyeMoodValue). SAD usa los párpados cansados,
+// TIRED son los ojos cerrados y solo HAPPY es curioso.
+static const int16_t moodTable[6][EYE_MOOD_VALUES] PROGMEM = {
+  //  tired sleepy angry happy open curious
+  {     0,    0,    0,    0,  256,    0 },  // 0 normal
+  {     0,    0,    0,    0,    0,    0 },  // 1 tired (cerrados)
+  {     0,    0,  128,    0,  256,    0 },  // 2 angry
+  {     0,    0,    0,  128,  256,  256 },  // 3 happy
+  {     0,  102,    0,    0,  256,    0 },  // 4 sleepy (2/5 del ojo)
+  {   128,    0,    0,    0,  256,    0 }   // 5 sad
+};
+
+static void loadMood(int mood, int16_t* out) {
+  if (mood < 0 || mood > 5) mood = 0;
+  for (int i = 0; i < EYE_MOOD_VALUES; i++) {
+    out[i] = (int16_t)pgm_read_word(&moodTable[mood][i]);
+  }
+}
+
+EyesManager::EyesManager()
+  : canvas(canvasBuffer, OLED_WIDTH, OLED_HEIGHT),
+    moodTween(EYE_MOOD_VALUES), gazeTween(EYE_GAZE_VALUES) {
   display = nullptr;
   eyes = nullptr;
-  lastBlinkTime = 0;
-  blinkInterval = 3000;
-  isBlinking = false;
+  clock = &systemClock;
+  rng = &systemRng;
+  drawnX = 0;
+  drawnW = 0;
+  drawnPage = 0;
+  drawnPages = 0;
+  state = EYE_ANIM_IDLE;
+  nextBlinkAt = 0;
+  nextGazeAt = 0;
+  blinkStartAt = 0;
   mood = 0; // normal
+  blinks = 0;
+  gazes = 0;
 }
 
-void EyesManager::initialize(Adafruit_SSD1306* disp) {
+void EyesManager::initialize(OledDisplay* disp, Clock* clk, Rng* rnd) {
   display = disp;
-  // Crear ojos RoboEyes con referencia al display
-  eyes = new RoboEyes<Adafruit_SSD1306>(*disp);
+  clock = clk;
+  rng = rnd;
+  // Crear ojos RoboEyes sobre el lienzo; las esquinas salen de la caché del display
+  canvas.setRoundRectCache(&disp->getRoundRectCache());
+  canvas.setEyelidCache(&eyelidCache);
+  eyes = new RoboEyes<PageCanvas>(canvas);
+  eyes->setClock(clk, rnd);  // Mismo tiempo que la máquina de estados
   // Inicializar RoboEyes
-  // Nota: begin() hace clearDisplay() internamente
-  eyes->begin(128, 64, 120);  // width, height, 120 FPS (animación mucho más rápida)
+  // Nota: begin() limpia el lienzo; el lienzo no tiene display() y nunca se envía.
+  // El límite de FPS de RoboEyes no se usa: el ritmo lo marca FrameGovernor
+  eyes->begin(128, 64, 50);
   eyes->setDisplayColors(0, 1);  // background=0, main=1
-  // Configuración estable con animaciones suaves
-  eyes->setAutoblinker(true, 5, 2); // parpadeo automático cada 3-7 segundos
-  eyes->setIdleMode(true, 10, 5);    // movimiento idle cada 5-15 segundos
-  eyes->setCuriosity(true);
+  eyes->setAutoFlush(false);     // Solo renderiza; DisplayManager::commitFrame() envía el frame
+  // Parpadeos y mirada los decide animate(), no los temporizadores de RoboEyes,
+  // y las transiciones las hace applyTweens() (incluido el ojo curioso, que
+  // depende del mood: columna curious de moodTable)
+  eyes->setAutoblinker(false);
+  eyes->setIdleMode(false);
+  eyes->setExternalTweening(true);
+  eyes->setCuriosity(false);
   eyes->setCyclops(false);
-  eyes->setMood(0); // DEFAULT (neutral)
-  eyes->setPosition(DEFAULT);
   eyes->setWidth(36, 36);
   eyes->setHeight(36, 36);
   eyes->setBorderradius(8, 8);
   eyes->setSpacebetween(10);
-  // Asegurar ojos abiertos desde el inicio
-  eyes->open();
-  eyes->eyeLheightCurrent = eyes->eyeLheightDefault;
-  eyes->eyeRheightCurrent = eyes->eyeRheightDefault;
-  eyes->eyeLheightNext = eyes->eyeLheightDefault;
-  eyes->eyeRheightNext = eyes->eyeRheightDefault;
+  eyes->setPosition(DEFAULT);
+  
+  // Ojos abiertos, mood neutro y mirando al centro desde el primer frame
+  unsigned long now = clock->now();
+  int16_t values[EYE_MOOD_VALUES];
+  loadMood(mood, values);
+  moodTween.jump(values);
+  startGaze(eyes->eyeLxNext, eyes->eyeLyNext, now, 0);
+  state = EYE_ANIM_IDLE;
+  scheduleBlink(now);
+  scheduleGaze(now);
+  
   // Dibujar un frame inicial
-  eyes->drawEyes();
+  drawEyesAnimated(true);
   display->display();
-  lastBlinkTime = millis();
 }
 
-void EyesManager::update() {
-  unsigned long currentTime = millis();
-  if (currentTime - lastBlinkTime >= blinkInterval) {
-    isBlinking = !isBlinking;
-    lastBlinkTime = currentTime;
-    if (isBlinking) {
-      blinkInterval = 40; // Parpadeo más rápido
-      log_i("Blink ON");
-    } else {
-      blinkInterval = 1200 + random(800); // Intervalo más corto
-      log_i("Blink OFF");
-    }
-  }
-  drawEyes();
-}
+// ==================== MÁQUINA DE ESTADOS ====================
 
-void EyesManager::drawEyesAnimated() {
-  if (display == nullptr || eyes == nullptr) return;
+void EyesManager::scheduleBlink(unsigned long now) {
+  nextBlinkAt = now + EYE_BLINK_INTERVAL_MS + rng->next(EYE_BLINK_VARIATION_MS);
+}
 
-  // RoboEyes gestiona el frame rate internamente
-  eyes->update();
+void EyesManager::scheduleGaze(unsigned long now) {
+  nextGazeAt = now + EYE_GAZE_INTERVAL_MS + rng->next(EYE_GAZE_VARIATION_MS);
 }
 
-void EyesManager::setMood(int newMood) {
-  if (newMood != mood) {
-    mood = newMood;
-    if (newMood >= 0 && newMood <= 4) {
-      eyes->setMood(newMood);
+void EyesManager::animate(unsigned long now) {
+  // Cada evento ocurre a su hora programada aunque el frame llegue tarde, y
+  // se encadenan todos los vencidos: el resultado no depende del ritmo de loop()
+  for (;;) {
+    switch (state) {
+      case EYE_ANIM_IDLE: {
+        bool blinkDue = (long)(now - nextBlinkAt) >= 0;
+        bool gazeDue = (long)(now - nextGazeAt) >= 0;
+        if (blinkDue && (!gazeDue || (long)(nextBlinkAt - nextGazeAt) <= 0)) {
+          // Cierra y reabre en EYE_BLINK_MS (ver getBlinkOpenness)
+          blinkStartAt = nextBlinkAt;
+          blinks++;
+          state = EYE_ANIM_BLINKING;
+          nextBlinkAt = blinkStartAt + EYE_BLINK_MS;
+        } else if (gazeDue) {
+          // Mirar a un punto al azar dentro de la pantalla
+          int16_t x = rng->next(eyes->getScreenConstraint_X());
+          int16_t y = rng->next(eyes->getScreenConstraint_Y());
+          startGaze(x, y, nextGazeAt, EYE_GAZE_MOVE_MS);
+          gazes++;
+          scheduleGaze(nextGazeAt);
+        } else {
+          return;
+        }
+        break;
+      }
+      
+      case EYE_ANIM_BLINKING: {
+        if ((long)(now - nextBlinkAt) < 0) return;
+        unsigned long endAt = nextBlinkAt;
+        state = EYE_ANIM_IDLE;
+        scheduleBlink(endAt);
+        // Un cambio de mirada vencido durante el parpadeo se hace al terminar
+        if ((long)(endAt - nextGazeAt) > 0) nextGazeAt = endAt;
+        break;
+      }
+      
+      case EYE_ANIM_CLOSED:
+        // Se sale al cambiar de mood (setMood)
+        return;
     }
-    log_i("Eyes mood changed to: %d", newMood);
   }
 }
 
-void EyesManager::drawEyes() {
-  if (display == nullptr || eyes == nullptr) return;
+void EyesManager::setMood(int newMood) {
+  if (newMood == mood) return;
+  mood = newMood;
   
-  unsigned long currentTime = millis();
+  // Fundido desde donde estén ahora (aunque otro cambio siga a medias)
+  unsigned long now = clock->now();
+  int16_t target[EYE_MOOD_VALUES];
+  loadMood(newMood, target);
+  moodTween.start(target, now, EYE_MOOD_BLEND_MS);
   
-  // Control de parpadeo
-  if (currentTime - lastBlinkTime >= blinkInterval) {
-    isBlinking = !isBlinking;
-    lastBlinkTime = currentTime;
-    if (isBlinking) {
-      blinkInterval = 40;  // Parpadeo más rápido
-      eyes->eyeL_open = false;
-      eyes->eyeR_open = false;
-    } else {
-      blinkInterval = 1200 + random(800);  // Intervalo más corto
-      eyes->eyeL_open = true;
-      eyes->eyeR_open = true;
-    }
-  }
-  
-  // Aplicar mood/expresión
-  switch(mood) {
-    case 1:  // TIRED = DEFAULT con ojos cerrados
-      eyes->tired = false;
-      eyes->sleepy = false;
-      eyes->happy = false;
-      eyes->angry = false;
-      eyes->curious = false;
-      eyes->eyeL_open = false;
-      eyes->eyeR_open = false;
-      break;
-    case 2:  // ANGRY
-      eyes->angry = true;
-      eyes->happy = false;
-      eyes->tired = false;
-      eyes->sleepy = false;
-      break;
-    case 3:  // HAPPY
-      eyes->happy = true;
-      eyes->angry = false;
-      eyes->tired = false;
-      eyes->sleepy = false;
-      eyes->curious = true;
-      break;
-    case 4:  // SLEEPY (50% cerrado)
-      eyes->sleepy = true;
-      eyes->angry = false;
-      eyes->happy = false;
-      eyes->tired = false;
-      eyes->eyeL_open = true;
-      eyes->eyeR_open = true;
-      eyes->curious = false;
-      break;
-    case 5:  // SAD
-      eyes->angry = false;
-      eyes->happy = false;
-      eyes->tired = true;
-      eyes->sleepy = false;
-      eyes->eyeL_open = true;
-      eyes->eyeR_open = true;
-      eyes->curious = false;
-      break;
-    default:  // NORMAL
-      eyes->happy = false;
-      eyes->angry = false;
-      eyes->tired = false;
-      eyes->sleepy = false;
-      eyes->curious = false;
-      break;
+  if (newMood == 1) {
+    // Ojos cerrados: sin parpadeos ni miradas
+    state = EYE_ANIM_CLOSED;
+  } else if (state == EYE_ANIM_CLOSED) {
+    // Al reabrirlos se vuelve a programar todo
+    state = EYE_ANIM_IDLE;
+    scheduleBlink(now);
+    scheduleGaze(now);
   }
+  log_i("Eyes mood changed to: %d", newMood);
 }
 
-void EyesManager::setHappy() {
-  mood = 3;
-}
+// ==================== TRANSICIONES ====================
 
-void EyesManager::setSad() {
-  mood = 5;
+void EyesManager::startGaze(int16_t x, int16_t y, unsigned long now, uint16_t ms) {
+  // El ojo que mira hacia su lado de la pantalla crece, con la misma regla
+  // que el modo curioso de RoboEyes; applyTweens() lo escala por el mood
+  int16_t rightX = x + eyes->eyeLwidthDefault + eyes->spaceBetweenDefault;
+  int16_t target[EYE_GAZE_VALUES];
+  target[EYE_GAZE_X] = x;
+  target[EYE_GAZE_Y] = y;
+  target[EYE_GAZE_OFFSET_L] = (x <= 10) ? EYE_CURIOUS_OFFSET : 0;
+  target[EYE_GAZE_OFFSET_R] = (rightX >= eyes->screenWidth - eyes->eyeRwidthDefault - 10) ? EYE_CURIOUS_OFFSET : 0;
+  if (ms == 0) gazeTween.jump(target);
+  else gazeTween.start(target, now, ms);
 }
 
-void EyesManager::setNormal() {
-  mood = 0;
+int16_t EyesManager::getBlinkOpenness(unsigned long now) {
+  if (state != EYE_ANIM_BLINKING) return 256;
+  // Media parpadeo cerrando y media abriendo, con la misma curva
+  unsigned long elapsed = now - blinkStartAt;
+  const unsigned long half = EYE_BLINK_MS / 2;
+  if (elapsed < half) return 256 - eyeEase(elapsed, half);
+  return 1 + eyeEase(elapsed - half, half);
 }
 
-void EyesManager::setSleep() {
-  mood = 3;
-  isBlinking = true;
+void EyesManager::applyTweens(unsigned long now) {
+  int16_t m[EYE_MOOD_VALUES];
+  int16_t g[EYE_GAZE_VALUES];
+  moodTween.sample(now, m);
+  gazeTween.sample(now, g);
+  
+  // Apertura del mood por la del parpadeo (256 = abiertos); el ojo curioso
+  // solo crece en los moods que lo tienen
+  int32_t open = ((int32_t)m[EYE_MOOD_OPEN] * getBlinkOpenness(now)) >> 8;
+  int32_t curious = (open * m[EYE_MOOD_CURIOUS]) >> 8;
+  int16_t offsetL = (g[EYE_GAZE_OFFSET_L] * curious) >> 8;
+  int16_t offsetR = (g[EYE_GAZE_OFFSET_R] * curious) >> 8;
+  eyes->eyeLheightNext = max(1, (int)((eyes->eyeLheightDefault * open) >> 8));
+  eyes->eyeRheightNext = max(1, (int)((eyes->eyeRheightDefault * open) >> 8));
+  eyes->eyeLheightOffset = offsetL;
+  eyes->eyeRheightOffset = offsetR;
+  eyes->eyeLxNext = g[EYE_GAZE_X];
+  eyes->eyeLyNext = g[EYE_GAZE_Y];
+  
+  // Párpados proporcionales al alto del ojo izquierdo, como en RoboEyes
+  int32_t lidBase = eyes->eyeLheightNext + offsetL;
+  eyes->eyelidsTiredHeight = (m[EYE_MOOD_TIRED] * lidBase) >> 8;
+  eyes->eyelidsSleepyHeight = (m[EYE_MOOD_SLEEPY] * lidBase) >> 8;
+  eyes->eyelidsAngryHeight = (m[EYE_MOOD_ANGRY] * lidBase) >> 8;
+  eyes->eyelidsHappyBottomOffset = (m[EYE_MOOD_HAPPY] * lidBase) >> 8;
 }
 
-void EyesManager::setBlink() {
-  isBlinking = true;
+// ==================== RENDER ====================
+
+bool EyesManager::drawEyesAnimated(bool bufferLost) {
+  if (display == nullptr || eyes == nullptr) return false;
+  
+  unsigned long now = clock->now();
+  animate(now);
+  applyTweens(now);
+  
+  // Otra pantalla ha pisado el buffer: borrarlo y redibujar aunque los ojos
+  // estén en reposo
+  if (bufferLost) {
+    eyes->invalidate();
+    display->clearDisplay();
+    drawnW = 0;
+    drawnPages = 0;
+  }
+  
+  // En reposo (sin transiciones ni animaciones de RoboEyes) el frame sería
+  // igual al anterior: no se dibuja ni se envía
+  if (eyes->isAtRest()) return false;
+  eyes->prepareFrame();
+  
+  // Ajustar el lienzo a la caja de este frame, recortada a la pantalla y
+  // ampliada a páginas completas para copiarla byte a byte
+  int16_t x, y, w, h;
+  eyes->getFrameBounds(x, y, w, h);
+  int16_t x0 = max(0, (int)x);
+  int16_t x1 = min(OLED_WIDTH, x + w);
+  int16_t p0 = max(0, (int)y) / 8;
+  int16_t p1 = min(OLED_PAGES, (y + h + 7) / 8);
+  if (x1 <= x0 || p1 <= p0) {
+    x0 = x1 = 0;
+    p0 = p1 = 0;
+  }
+  canvas.setWindow(x0, p0 * 8, x1 - x0, (p1 - p0) * 8);
+  eyes->renderFrame();
+  
+  composite(x0, p0, x1 - x0, p1 - p0);
+  return true;
 }
 
-void EyesManager::setAwake() {
-  mood = 0;
-  isBlinking = false;
+void EyesManager::composite(int16_t x, int16_t page, int16_t w, int16_t pages) {
+  uint8_t* frame = display->getBuffer();
+  
+  // Fuera de la caja de RoboEyes todo es fondo: basta con borrar la del
+  // frame anterior y copiar encima la nueva
+  pageFillRect(frame, OLED_WIDTH, OLED_HEIGHT, drawnX, drawnPage * 8, drawnW, drawnPages * 8, SSD1306_BLACK);
+  for (int16_t p = 0; p < pages; p++) {
+    memcpy(frame + (page + p) * OLED_WIDTH + x, canvasBuffer + p * w, w);
+  }
+  RENDER_COUNT(display, blits, 1);
+  RENDER_COUNT(display, pixels, (unsigned long)w * pages * 8);
+  
+  drawnX = x;
+  drawnW = w;
+  drawnPage = page;
+  drawnPages = pages;
 }
 
-void EyesManager::lookUp() {
-  if (eyes == nullptr) return;
-  // N = North (arriba, centro)
-  // Necesitamos usar las constantes de RoboEyes
-  eyes->setPosition(1);  // 1 = N (North) en RoboEyes
+bool EyesManager::isAtRest() {
+  if (eyes == nullptr) return false;
+  return eyes->isAtRest() && (long)(clock->now() - getNextChangeAt()) < 0;
 }
 
-void EyesManager::lookCenter() {
-  if (eyes == nullptr) return;
-  // DEFAULT = centro
-  eyes->setPosition(0);  // 0 = DEFAULT en RoboEyes
+unsigned long EyesManager::getNextChangeAt() {
+  // Parpadeo o transición en curso: cambia en cada frame
+  unsigned long now = clock->now();
+  if (state == EYE_ANIM_BLINKING || moodTween.isActive(now) || gazeTween.isActive(now)) return now;
+  // Con los ojos cerrados no hay nada programado
+  if (state == EYE_ANIM_CLOSED) return now + EYE_GAZE_INTERVAL_MS;
+  return ((long)(nextBlinkAt - nextGazeAt) < 0) ? nextBlinkAt : nextGazeAt;
 }
@@ -0,0 +1,57 @@
+#include "eyetween.h"
+
+// 255 * (3t² - 2t³) para t = i / EYE_EASE_STEPS
+static const uint8_t easeTable[EYE_EASE_STEPS + 1] PROGMEM = {
+  0, 0, 1, 2, 3, 4, 6, 8, 11, 14, 17, 20, 24, 27, 31, 35,
+  40, 44, 49, 54, 59, 64, 70, 75, 81, 86, 92, 98, 104, 110, 116, 122,
+  128, 133, 139, 145, 151, 157, 163, 169, 174, 180, 185, 191, 196, 201, 206, 211,
+  215, 220, 224, 228, 231, 235, 238, 241, 244, 247, 249, 251, 252, 253, 254, 255,
+  255
+};
+
+uint8_t eyeEase(unsigned long elapsed, unsigned long duration) {
+  if (duration == 0 || elapsed >= duration) return 255;
+  return pgm_read_byte(&easeTable[elapsed * EYE_EASE_STEPS / duration]);
+}
+
+EyeTween::EyeTween(uint8_t values) {
+  count = min((int)values, EYE_TWEEN_VALUES);
+  startAt = 0;
+  duration = 0;
+  for (int i = 0; i < EYE_TWEEN_VALUES; i++) {
+    from[i] = 0;
+    to[i] = 0;
+  }
+}
+
+void EyeTween::jump(const int16_t* values) {
+  for (int i = 0; i < count; i++) {
+    from[i] = values[i];
+    to[i] = values[i];
+  }
+  duration = 0;
+}
+
+void EyeTween::start(const int16_t* target, unsigned long now, uint16_t ms) {
+  // Partir de donde está ahora para que no haya saltos al encadenar
+  int16_t current[EYE_TWEEN_VALUES];
+  sample(now, current);
+  for (int i = 0; i < count; i++) {
+    from[i] = current[i];
+    to[i] = target[i];
+  }
+  startAt = now;
+  duration = ms;
+}
+
+void EyeTween::sample(unsigned long now, int16_t* out) const {
+  unsigned long elapsed = now - startAt;
+  if (elapsed >= duration) {
+    for (int i = 0; i < count; i++) out[i] = to[i];
+    return;
+  }
+  int32_t ease = pgm_read_byte(&easeTable[elapsed * EYE_EASE_STEPS / duration]);
+  for (int i = 0; i < count; i++) {
+    out[i] = from[i] + (((int32_t)(to[i] - from[i]) * ease) >> 8);
+  }
+}
@@ -1,5 +1,6 @@
 #include "game.h"
 #include <Preferences.h>
+#include "storage.h"
 
 DodgeGame::DodgeGame() {
   playerLane = 1;  // Carril central
@@ -12,13 +13,17 @@ DodgeGame::DodgeGame() {
   obstacleCount = 0;
   boxesDodgedThisLevel = 0;
   maxActiveObstacles = 1;
+  clock = &systemClock;
+  rng = &systemRng;
   
   for (int i = 0; i < MAX_OBSTACLES; i++) {
     obstacles[i].active = false;
   }
 }
 
-void DodgeGame::initialize() {
+void DodgeGame::initialize(Clock* clk, Rng* rnd) {
+  clock = clk;
+  rng = rnd;
   loadRecord();
   reset();
 }
@@ -33,10 +38,7 @@ void DodgeGame::loadRecord() {
 void DodgeGame::saveRecord() {
   if (level > record) {
     record = level;
-    Preferences prefs;
-    prefs.begin("tamagotchi", false);
-    prefs.putInt("gameRecord", record);
-    prefs.end();
+    storage.putInt("tamagotchi", "gameRecord", record);
   }
 }
 
@@ -45,8 +47,8 @@ void DodgeGame::reset() {
   score = 0;
   level = 1;
   obstacleSpeed = 2;
-  lastObstacleTime = millis();
-  lastUpdateTime = millis();
+  lastObstacleTime = clock->now();
+  lastUpdateTime = clock->now();
   obstacleCount = 0;
   boxesDodgedThisLevel = 0;
   maxActiveObstacles = 1; // Empezar con 1 caja
@@ -57,7 +59,7 @@ void DodgeGame::reset() {
 }
 
 void DodgeGame::update() {
-  unsigned long currentTime = millis();
+  unsigned long currentTime = clock->now();
   
   // Spawnear obstáculos
   if (currentTime - lastObstacleTime >= max(1000 - level * 50, 200)) { // Aumenta frecuencia
@@ -86,7 +88,7 @@ void DodgeGame::spawnObstacle() {
   for (int i = 0; i < MAX_OBSTACLES; i++) {
     if (!obstacles[i].active) {
       obstacles[i].x = GAME_WIDTH;
-      obstacles[i].lane = random(1, 3);  // Solo carriles 1 (central) y 2 (inferior)
+      obstacles[i].lane = rng->next(1, 3);  // Solo carriles 1 (central) y 2 (inferior)
       obstacles[i].active = true;
       obstacleCount++;
       break;
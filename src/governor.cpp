@@ -0,0 +1,78 @@
+#include "governor.h"
+
+unsigned long pacedFrameInterval(unsigned long sceneMs, unsigned long flushMicros) {
+  unsigned long busMs = (flushMicros + 999) / 1000 + FRAME_BUS_MARGIN_MS;
+  if (busMs <= sceneMs) return sceneMs;
+  return min(busMs, (unsigned long)FRAME_MS_MAX);
+}
+
+FrameGovernor::FrameGovernor() {
+  interval = FRAME_MS_EYES;
+  frameStart = 0;
+  deadline = 0;
+  busyStart = 0;
+  behind = false;
+  skippedLast = false;
+  resetStats();
+}
+
+void FrameGovernor::beginFrame() {
+  frameStart = millis();
+  deadline = frameStart + interval;
+  busyStart = micros();
+}
+
+void FrameGovernor::setInterval(unsigned long ms) {
+  interval = ms;
+  deadline = frameStart + interval;
+}
+
+bool FrameGovernor::shouldPresent() {
+  // Si el frame anterior llegó tarde, saltar este envío para recuperar el
+  // ritmo. El buffer sigue marcado como sucio y sale en el siguiente.
+  if (behind && !skippedLast) {
+    skippedFrames++;
+    skippedLast = true;
+    return false;
+  }
+  skippedLast = false;
+  return true;
+}
+
+void FrameGovernor::endFrame() {
+  frames++;
+  busyMicros += micros() - busyStart;
+  
+  unsigned long now = millis();
+  if ((long)(now - deadline) > 0) {
+    missedDeadlines++;
+    behind = true;
+    // loop() tiene más prioridad que el envío y la persistencia: aunque vaya
+    // con retraso cede un tick para que no se queden sin CPU
+    delay(1);
+  } else {
+    behind = false;
+    // Ceder la CPU al resto de tareas (envío al OLED) hasta el plazo
+    delay(deadline - now);
+  }
+  
+  totalMicros += micros() - busyStart;
+}
+
+void FrameGovernor::resync() {
+  behind = false;
+  skippedLast = false;
+}
+
+unsigned long FrameGovernor::getLoadPercent() const {
+  if (totalMicros == 0) return 0;
+  return (unsigned long)((unsigned long long)busyMicros * 100 / totalMicros);
+}
+
+void FrameGovernor::resetStats() {
+  frames = 0;
+  skippedFrames = 0;
+  missedDeadlines = 0;
+  busyMicros = 0;
+  totalMicros = 0;
+}
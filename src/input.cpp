@@ -0,0 +1,172 @@
+#include "input.h"
+
+// ==================== CAPTURA ====================
+
+ButtonInput::ButtonInput() {
+  head = 0;
+  tail = 0;
+  rawPressed = false;
+  rawAt = 0;
+  overflows = 0;
+  pin = 0;
+  attached = false;
+}
+
+void ButtonInput::begin(uint8_t buttonPin) {
+  pin = buttonPin;
+  pinMode(pin, INPUT_PULLUP);
+  rawPressed = (digitalRead(pin) == LOW);
+  rawAt = millis();
+  resume();
+}
+
+void ARDUINO_ISR_ATTR ButtonInput::capture(unsigned long now) {
+  bool pressed = (digitalRead(pin) == LOW);
+  if (pressed == rawPressed) return;
+  rawPressed = pressed;
+  rawAt = now;
+
+  // Solo la ISR escribe head; tail se lee con acquire para no pisar un hueco
+  // que loop() todavía está copiando
+  uint8_t next = (head + 1) & (BUTTON_RING_SIZE - 1);
+  if (next == __atomic_load_n(&tail, __ATOMIC_ACQUIRE)) {
+    // Cola llena: el decodificador se resincroniza con rawPressed
+    overflows++;
+    return;
+  }
+  ring[head].at = now;
+  ring[head].pressed = pressed;
+  // Publicar con release: el flanco queda escrito antes de que loop() vea head
+  __atomic_store_n(&head, next, __ATOMIC_RELEASE);
+}
+
+#ifdef ARDUINO_ARCH_ESP32
+void ARDUINO_ISR_ATTR ButtonInput::isrEntry(void* arg) {
+  ButtonInput* self = static_cast<ButtonInput*>(arg);
+  self->capture(millis());
+}
+
+void ButtonInput::suspend() {
+  if (!attached) return;
+  detachInterrupt(pin);
+  attached = false;
+}
+
+void ButtonInput::resume() {
+  if (attached) return;
+  // Sin la ISR enganchada esto es el único productor
+  capture(millis());
+  attachInterruptArg(pin, isrEntry, this, CHANGE);
+  attached = true;
+}
+
+void ButtonInput::poll(unsigned long now) {
+}
+#else
+void ButtonInput::suspend() {
+}
+
+void ButtonInput::resume() {
+  capture(millis());
+}
+
+void ButtonInput::poll(unsigned long now) {
+  capture(now);
+}
+#endif
+
+bool ButtonInput::pop(ButtonEdge& out) {
+  // acquire: ring[tail] se lee después de ver el head que lo publicó
+  if (tail == __atomic_load_n(&head, __ATOMIC_ACQUIRE)) return false;
+  out = ring[tail];
+  // release: el hueco se libera después de copiarlo
+  __atomic_store_n(&tail, (uint8_t)((tail + 1) & (BUTTON_RING_SIZE - 1)), __ATOMIC_RELEASE);
+  return true;
+}
+
+// ==================== GESTOS ====================
+
+GestureDecoder::GestureDecoder() {
+  button = nullptr;
+  pendingCount = 0;
+  pendingNext = 0;
+  down = false;
+  changedAt = 0;
+  downAt = 0;
+  holdSent = false;
+  lastWasShort = false;
+  lastShortAt = 0;
+}
+
+void GestureDecoder::begin(ButtonInput* input) {
+  button = input;
+}
+
+void GestureDecoder::emit(ButtonEventType type, unsigned long at, unsigned long duration) {
+  ButtonEvent& event = pending[pendingCount++];
+  event.type = type;
+  event.at = at;
+  event.duration = duration;
+}
+
+void GestureDecoder::accept(bool pressed, unsigned long at, bool force) {
+  if (pressed == down) return;
+  // Un cambio tan cerca del anterior es un rebote: el nivel vuelve enseguida
+  if (!force && at - changedAt < BUTTON_DEBOUNCE_MS) return;
+  down = pressed;
+  changedAt = at;
+
+  if (pressed) {
+    downAt = at;
+    holdSent = false;
+    emit(BUTTON_DOWN, at, 0);
+    return;
+  }
+
+  unsigned long duration = at - downAt;
+  emit(BUTTON_UP, at, duration);
+  if (duration >= BUTTON_LONG_MS) {
+    emit(BUTTON_LONG_PRESS, at, duration);
+    lastWasShort = false;
+    return;
+  }
+  emit(BUTTON_SHORT_PRESS, at, duration);
+  if (lastWasShort && at - lastShortAt <= BUTTON_DOUBLE_MS) {
+    emit(BUTTON_DOUBLE_PRESS, at, duration);
+    lastWasShort = false;
+  } else {
+    lastWasShort = true;
+    lastShortAt = at;
+  }
+}
+
+bool GestureDecoder::next(unsigned long now, ButtonEvent& out) {
+  if (button == nullptr) return false;
+
+  if (pendingNext >= pendingCount) {
+    pendingCount = 0;
+    pendingNext = 0;
+    button->poll(now);
+
+    ButtonEdge edge;
+    while (pendingCount == 0 && button->pop(edge)) {
+      accept(edge.pressed, edge.at, false);
+    }
+
+    // Con la cola vacía el nivel debería coincidir: si no, se perdió un
+    // flanco (cola llena) o el último se tomó por rebote
+    if (pendingCount == 0 && button->isPressed() != down &&
+        now - button->getLastChangeAt() >= BUTTON_DEBOUNCE_MS) {
+      accept(button->isPressed(), button->getLastChangeAt(), true);
+    }
+
+    if (pendingCount == 0 && down && !holdSent && now - downAt >= BUTTON_HOLD_MS) {
+      holdSent = true;
+      emit(BUTTON_HOLD, now, now - downAt);
+    }
+  }
+
+  if (pendingNext >= pendingCount) return false;
+  out = pending[pendingNext++];
+  return true;
+}
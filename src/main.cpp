@@ -7,7 +7,18 @@
 #include "game.h"
 #include "memorygame.h"
 #include "tictactoe.h"
+#include "oled.h"
 #include "display.h"
+#include "power.h"
+#include "governor.h"
+#include "timeline.h"
+#include "scheduler.h"
+#include "audio.h"
+#include "input.h"
+#include "storage.h"
+#ifdef RENDER_BENCHMARK
+#include "benchmark.h"
+#endif
 
 // Configuración de pines
 #define BTN_ENTER 1
@@ -15,8 +26,18 @@
 #define I2C_SDA 8
 #define I2C_SCL 9
 
-// Declarar el display
-Adafruit_SSD1306 display(128, 64, &Wire, -1);
+// Prioridades FreeRTOS: la lógica (loop) por encima del envío al OLED y
+// este por encima de las escrituras en flash
+#define LOGIC_TASK_PRIORITY 3
+#define RENDER_TASK_PRIORITY 2
+#define STORAGE_TASK_PRIORITY 1
+
+// Periodos de las tareas de fondo (ms)
+#define PET_TASK_MS 500      // Simulación de la mascota
+#define STATS_TASK_MS 2000   // Estadísticas por el puerto serie
+
+// Declarar el display (solo envía por I2C las páginas modificadas)
+OledDisplay display(&Wire);
 
 // Variables globales
 Tamagotchi pet;
@@ -24,622 +45,822 @@ DodgeGame game;
 MemoryGame memoryGame;
 TicTacToeGame ticTacToeGame;
 DisplayManager displayMgr;
-unsigned long lastUpdateTime = 0;
-unsigned long gameStartTime = 0;
+PowerManager power;
+FrameGovernor governor;
+Scheduler scheduler; // Escena activa y tareas de fondo de loop()
+Timeline timeline; // Secuencias de ojos y sonido sin bloquear loop()
+AudioEngine audio; // Buzzer en segundo plano
+ButtonInput button; // Flancos del botón capturados por interrupción
+GestureDecoder gestures; // Flancos -> eventos para la escena activa
+int petTask = -1;
 unsigned long menuOpenTime = 0;
-bool inGame = false;
-bool inMemoryGame = false;
-bool inTicTacToe = false;
-bool showMenu = false;
-bool showGameMenu = false; // Submenú de juegos
-bool showShopMenu = false; // Submenú de tienda
+unsigned long gameTickTime = 0; // Último tick del juego de esquivar
 bool soundEnabled = true; // Control de sonido (ON/OFF)
 int menuOption = 0; // 0: TIENDA, 1: JUGAR, 2: DORMIR, 3: SOUND
 int gameMenuOption = 0; // 0: ESQUIVAR, 1: MEMORIA
 int shopMenuOption = 0; // 0: Manzana, 1: Pan, 2: Queso, 3: Tarta, 4: Juego de memoria
 const unsigned long MENU_TIMEOUT = 5000; // Cerrar menú después de 5 segundos sin actividad
-const unsigned long LONG_PRESS_TIME = 500; // 500ms para considerar pulsación larga
-Preferences soundPrefs; // Para guardar estado del sonido
+const unsigned long GAME_OVER_TIME = 3000; // Pantalla de fin de partida (se puede saltar)
+const unsigned long BOARD_PAUSE_TIME = 500; // Tablero final del tres en raya antes del resultado
+int gameOverCoins = 0; // Monedas que muestra la pantalla de fin de partida
+
+// Escenas a las que se puede ir desde otra escena
+enum SceneId {
+  SCENE_MAIN,
+  SCENE_MENU,
+  SCENE_GAME_MENU,
+  SCENE_SHOP,
+  SCENE_DODGE,
+  SCENE_MEMORY,
+  SCENE_TICTACTOE,
+  SCENE_GAME_OVER
+};
 
 // Declaraciones forward
 void playHappySound();
-void playAngrySound();
+void playAngrySound(AudioPriority priority = AUDIO_PRIORITY_EVENT);
 void playBoredSound();
 void playSleepySound();
 void playBeep();
-void startGame();
-void updateGame();
-void endGame();
-void startMemoryGame();
-void updateMemoryGame();
-void endMemoryGame();
+void goToScene(SceneId id);
+void startGame(unsigned long now);
+void endGame(unsigned long now);
+void drawGameOver();
+void finishGame();
+void startMemoryGame(unsigned long now);
+void endMemoryGame(unsigned long now);
+void drawMemoryGameOver();
+void finishMemoryGame();
+void scheduleMemorySequence(bool levelUp, unsigned long now);
+void runTimeline(unsigned long now);
+void drawTimeline();
+void cancelTimeline();
 void startTicTacToe();
-void updateTicTacToe();
+void showFinalBoard(unsigned long now);
+void drawFinalBoard();
 void endTicTacToe();
-void handleButtons();
-void playSound(int frequency, int duration);
+void drawTicTacToeGameOver();
+void finishTicTacToe();
+unsigned long eyesFrameInterval();
+void petTaskRun(unsigned long now);
+void alertTaskRun(unsigned long now);
+void audioTaskRun(unsigned long now);
+void storageTaskRun(unsigned long now);
+void focusTaskRun(unsigned long now);
+void statsTaskRun(unsigned long now);
+void logPacing(unsigned long now);
+void playSound(int frequency, int duration, AudioPriority priority = AUDIO_PRIORITY_FEEDBACK);
+
+
+// Melodías del buzzer: frecuencia, duración y silencio posterior (ms).
+// AudioEngine las reproduce en segundo plano; encolarlas no bloquea loop()
+static const AudioNote happyNotes[] = {   // Melodía ascendente
+  {2500, 80, 10}, {3000, 80, 10}, {3500, 80, 10}, {4000, 80, 10}
+};
+static const AudioNote angryNotes[] = {   // Dos notas graves descendentes
+  {1200, 120, 10}, {900, 120, 10}
+};
+static const AudioNote boredNotes[] = {   // Tres notas monótonas y bajas
+  {600, 150, 30}, {600, 150, 30}, {600, 150, 30}
+};
+static const AudioNote sleepyNotes[] = {  // Dos notas descendentes suaves y lentas
+  {800, 200, 50}, {400, 200, 50}
+};
 
 // Sonido feliz: melodía ascendente
 void playHappySound() {
-  if (!soundEnabled) return;
-  int melody[] = {2500, 3000, 3500, 4000};
-  int noteDuration = 80;
-  for (int i = 0; i < 4; ++i) {
-    tone(BUZZER_PIN, melody[i], noteDuration);
-    delay(noteDuration + 10);
-  }
-  noTone(BUZZER_PIN);
+  audio.play(happyNotes, 4, AUDIO_PRIORITY_EVENT);
 }
 
 // Sonido enfadado: dos notas graves descendentes
-void playAngrySound() {
-  if (!soundEnabled) return;
-  int melody[] = {1200, 900};
-  int noteDuration = 120;
-  for (int i = 0; i < 2; ++i) {
-    tone(BUZZER_PIN, melody[i], noteDuration);
-    delay(noteDuration + 10);
-  }
-  noTone(BUZZER_PIN);
+void playAngrySound(AudioPriority priority) {
+  audio.play(angryNotes, 2, priority);
 }
 
 // Sonido aburrido: tres notas monótonas y bajas
 void playBoredSound() {
-  if (!soundEnabled) return;
-  int melody[] = {600, 600, 600};
-  int noteDuration = 150;
-  for (int i = 0; i < 3; ++i) {
-    tone(BUZZER_PIN, melody[i], noteDuration);
-    delay(noteDuration + 30);
-  }
-  noTone(BUZZER_PIN);
+  audio.play(boredNotes, 3, AUDIO_PRIORITY_ALERT);
 }
 
 // Sonido de sueño: dos notas descendentes suaves y lentas
 void playSleepySound() {
-  if (!soundEnabled) return;
-  int melody[] = {800, 400};
-  int noteDuration = 200;
-  for (int i = 0; i < 2; ++i) {
-    tone(BUZZER_PIN, melody[i], noteDuration);
-    delay(noteDuration + 50);
-  }
-  noTone(BUZZER_PIN);
+  audio.play(sleepyNotes, 2, AUDIO_PRIORITY_ALERT);
 }
 
-void playSound(int frequency, int duration);
-
-void playSound(int frequency, int duration) {
-  if (!soundEnabled) return;
-  int testDuration = duration;
-  if (testDuration < 100) testDuration = 100;
-  tone(BUZZER_PIN, frequency, testDuration);
-  delay(testDuration + 20);
-  noTone(BUZZER_PIN);
+// Nota suelta; por debajo de 100 ms el buzzer apenas se oye
+void playSound(int frequency, int duration, AudioPriority priority) {
+  audio.playTone(frequency, max(duration, 100), priority, 20);
 }
 
 // Bip simple para botón
 void playBeep() {
-  if (!soundEnabled) return;
-  tone(BUZZER_PIN, 3000, 60);
-  delay(70);
-  noTone(BUZZER_PIN);
+  audio.playTone(3000, 60, AUDIO_PRIORITY_FEEDBACK, 10);
 }
 
-void setup() {
-  Serial.begin(115200);
-  Serial.setDebugOutput(true);
-  unsigned long serialStart = millis();
-  while (!Serial && (millis() - serialStart < 2000)) {
-    delay(10);
-  }
-  delay(200);
-  log_i("=== TAMAGOTCHI START ===");
-  // Inicializar pin del botón central
-  pinMode(BTN_ENTER, INPUT_PULLUP);
-  
-  // Inicializar buzzer
-  pinMode(BUZZER_PIN, OUTPUT);
-  
-  // Configurar pines I2C personalizados
-  Wire.begin(I2C_SDA, I2C_SCL);
+// ==================== ESCENAS ====================
+// Cada pantalla es una escena (scheduler.h) que reacciona a los eventos del
+// botón (input.h): pulsación corta, larga, al pulsar, al soltar...
+// Las de la mascota (caras, monedas insuficientes y dormir) interrumpen a la
+// actual sin cerrarla: un juego o un menú quedan en pausa y siguen después.
 
-  // Inicializar display OLED
-  if (!display.begin(SSD1306_SWITCHCAPVCC, 0x3C)) {
-    log_i("SSD1306 allocation failed");
-    for (;;);
-  }
-  
-  display.clearDisplay();
-  display.setTextSize(1);
-  display.setTextColor(SSD1306_WHITE);
-  display.setCursor(0, 0);
-  display.println("Tamagotchi Init...");
-  display.display();
-  
-  // Inicializar tamagotchi
-  pet.initialize();
+// Vista normal - solo ojos visible - Cualquier pulsación abre menú
+class MainScene : public Scene {
+public:
+  MainScene() : Scene("main") {}
   
-  // Inicializar juego
-  game.initialize();
+  void input(const ButtonEvent& event) override {
+    // Abrir menú con cualquier pulsación (al soltar)
+    if (event.type == BUTTON_SHORT_PRESS || event.type == BUTTON_LONG_PRESS) {
+      goToScene(SCENE_MENU);
+      playSound(150, 100);
+    }
+  }
   
-  // Inicializar juego de memoria
-  memoryGame.initialize();
+  void render() override { displayMgr.showMainScreen(); }
+  unsigned long frameInterval() const override { return eyesFrameInterval(); }
+};
+
+// Menú principal - Pulsación corta navega, larga selecciona
+class MenuScene : public Scene {
+public:
+  MenuScene() : Scene("menu") {}
   
-  // Inicializar juego de tres en raya
-  ticTacToeGame.initialize();
+  void enter(unsigned long now) override {
+    menuOption = 0;
+    menuOpenTime = now;
+  }
   
-  // Inicializar display manager
-  displayMgr.initialize(&display, &pet);
+  void input(const ButtonEvent& event) override {
+    if (event.type == BUTTON_SHORT_PRESS) {
+      // PULSACIÓN CORTA: Navegar hacia abajo
+      menuOption++;
+      if (menuOption > 3) menuOption = 0;
+      menuOpenTime = event.at;
+    } else if (event.type == BUTTON_LONG_PRESS) {
+      // PULSACIÓN LARGA: Seleccionar acción
+      bool success = false;
+      switch(menuOption) {
+        case 0: // TIENDA
+          goToScene(SCENE_SHOP);
+          playSound(200, 100);
+          break;
+        case 1: // JUGAR
+          goToScene(SCENE_GAME_MENU);
+          playSound(150, 100);
+          break;
+        case 2: // DORMIR
+          success = pet.sleep();
+          if (success) {
+            playSound(200, 50);
+          } else {
+            playSound(150, 50);
+          }
+          goToScene(SCENE_MAIN);
+          break;
+        case 3: // SOUND
+          soundEnabled = !soundEnabled;
+          audio.setEnabled(soundEnabled);
+          storage.putBool("sound", "enabled", soundEnabled);
+          menuOpenTime = event.at;
+          break;
+      }
+    }
+  }
   
-  // Cargar configuración de sonido
-  soundPrefs.begin("sound", false);
-  soundEnabled = soundPrefs.getBool("enabled", true); // Por defecto ON
+  void update(unsigned long now) override {
+    // Cerrar menú si pasó mucho tiempo
+    if (now - menuOpenTime > MENU_TIMEOUT) {
+      goToScene(SCENE_MAIN);
+    }
+  }
   
-  log_i("Tamagotchi initialized successfully!");
-}
+  void render() override { displayMgr.showMenuScreen(menuOption, soundEnabled); }
+  unsigned long frameInterval() const override { return FRAME_MS_MENU; }
+};
 
-void loop() {
-  unsigned long currentTime = millis();
-  static unsigned long lastHeartbeat = 0;
+// Submenú de juegos - Pulsación corta navega, larga selecciona
+class GameMenuScene : public Scene {
+public:
+  GameMenuScene() : Scene("gamemenu") {}
   
-  // Actualizar estado del tamagotchi cada 500ms
-  if (currentTime - lastUpdateTime >= 500) {
-    lastUpdateTime = currentTime;
-    pet.update();
+  void enter(unsigned long now) override {
+    gameMenuOption = 0;
+    menuOpenTime = now;
   }
   
-  // Reproducir sonidos de estado bajo (hambre, aburrimiento, sueño)
-  if (pet.playHungrySound) {
-    playAngrySound();
-    pet.playHungrySound = false;
+  void input(const ButtonEvent& event) override {
+    if (event.type == BUTTON_SHORT_PRESS) {
+      // Calcular total de juegos disponibles
+      int totalGames = 1; // Siempre hay esquivar
+      if (pet.getMemoryGameUnlocked()) totalGames++; // +1 si memoria desbloqueado
+      if (pet.getTicTacToeUnlocked()) totalGames++; // +1 si tres en raya desbloqueado
+      
+      // PULSACIÓN CORTA: Navegar hacia abajo
+      gameMenuOption++;
+      if (gameMenuOption >= totalGames) gameMenuOption = 0;
+      menuOpenTime = event.at;
+    } else if (event.type == BUTTON_LONG_PRESS) {
+      // PULSACIÓN LARGA: Seleccionar juego
+      log_i("Game menu: Selected option %d", gameMenuOption);
+      bool success = pet.play();
+      log_i("pet.play() returned: %d (coins: %d)", success, pet.getCoins());
+      SceneId next = SCENE_MAIN;
+      if (success) {
+        // Mapear la opción a juego real
+        if (gameMenuOption == 0) {
+          log_i("Starting dodge game...");
+          next = SCENE_DODGE;
+        } else if (gameMenuOption == 1) {
+          // Item 1 puede ser memoria o tres en raya
+          if (pet.getMemoryGameUnlocked()) {
+            log_i("Starting memory game...");
+            next = SCENE_MEMORY;
+          } else if (pet.getTicTacToeUnlocked()) {
+            log_i("Starting tic-tac-toe...");
+            next = SCENE_TICTACTOE;
+          }
+        } else if (gameMenuOption == 2) {
+          // Item 2 solo existe si memoria está desbloqueado
+          if (pet.getTicTacToeUnlocked()) {
+            log_i("Starting tic-tac-toe...");
+            next = SCENE_TICTACTOE;
+          }
+        }
+      } else {
+        log_i("Not enough coins to play!");
+        playSound(150, 50);
+      }
+      goToScene(next);
+    }
   }
-  if (pet.playBoredSound) {
-    playBoredSound();
-    pet.playBoredSound = false;
+  
+  void update(unsigned long now) override {
+    // Cerrar menú si pasó mucho tiempo
+    if (now - menuOpenTime > MENU_TIMEOUT) {
+      goToScene(SCENE_MAIN);
+    }
   }
-  if (pet.playSleepySound) {
-    playSleepySound();
-    pet.playSleepySound = false;
+  
+  void render() override { displayMgr.showGameMenuScreen(gameMenuOption); }
+  unsigned long frameInterval() const override { return FRAME_MS_MENU; }
+};
+
+// Tienda - Pulsación corta navega, larga compra. Si no hay monedas la
+// mascota activa showInsufficientCoins y el aviso interrumpe a la tienda
+class ShopScene : public Scene {
+public:
+  ShopScene() : Scene("shop") {}
+  
+  void enter(unsigned long now) override {
+    shopMenuOption = 0;
+    menuOpenTime = now;
   }
   
-  // Mostrar animación ANGRY o HAPPY si corresponde (superpone todo y bloquea botones)
-  static bool angrySoundPlayed = false;
-  static bool happySoundPlayed = false;
-  if (pet.showAngryFace) {
-    displayMgr.showMainScreen(); // Mostrará los ojos en modo ANGRY
-    if (!angrySoundPlayed) {
-      playAngrySound();
-      angrySoundPlayed = true;
-    }
-    // NO procesar botones durante la animación
-  } else if (pet.showHappyFace) {
-    displayMgr.showMainScreen(); // Mostrará los ojos en modo HAPPY
-    if (!happySoundPlayed) {
-      playHappySound();
-      happySoundPlayed = true;
-    }
-    angrySoundPlayed = false;
-    // NO procesar botones durante la animación
-  } else {
-    // Solo procesar botones si NO hay animaciones activas
-    // Y tampoco si se está mostrando el mensaje de monedas insuficientes
-    // Y tampoco si estamos en la tienda (la tienda tiene su propia lógica de botones)
-    if (!pet.showInsufficientCoins && !showShopMenu) {
-      handleButtons();
-    }
-    happySoundPlayed = false;
-    angrySoundPlayed = false;
-    // Prioridad: si estamos en la tienda, gestionar eso primero
-    if (showShopMenu) {
-      // Controles de la tienda y renderizado
+  void input(const ButtonEvent& event) override {
+    if (event.type == BUTTON_SHORT_PRESS) {
       // Calcular total de items disponibles
       int totalShopItems = 4; // Siempre hay 4 comidas
       if (!pet.getMemoryGameUnlocked()) totalShopItems++; // +1 si memoria no desbloqueado
       if (!pet.getTicTacToeUnlocked()) totalShopItems++; // +1 si tres en raya no desbloqueado
       
-      // Si hay mensaje de monedas insuficientes, mostrarlo y bloquear controles
-      if (pet.showInsufficientCoins) {
-        // Solo mostrar la pantalla de mensaje, sin aceptar controles
-        displayMgr.showInsufficientCoinsScreen();
-        if (millis() - menuOpenTime > MENU_TIMEOUT) {
-          showShopMenu = false;
-        }
-      } else {
-      // Detección de pulsaciones: corta = navegar, larga = seleccionar
-      static bool shopBtnPressed = false;
-      static unsigned long shopBtnPressTime = 0;
-      
-      bool currentShopEnterState = digitalRead(BTN_ENTER);
+      // PULSACIÓN CORTA: Navegar hacia abajo (cíclico)
+      shopMenuOption++;
+      if (shopMenuOption >= totalShopItems) shopMenuOption = 0;
+      menuOpenTime = event.at;
+    } else if (event.type == BUTTON_LONG_PRESS) {
+      // PULSACIÓN LARGA: Seleccionar (comprar)
+      bool bought = false;
       
-      // Detectar cuando se presiona el botón
-      if (!shopBtnPressed && currentShopEnterState == LOW) {
-        shopBtnPressed = true;
-        shopBtnPressTime = millis();
-      }
-      
-      // Detectar cuando se suelta el botón
-      if (shopBtnPressed && currentShopEnterState == HIGH) {
-        unsigned long pressDuration = millis() - shopBtnPressTime;
-        shopBtnPressed = false;
-        
-        if (pressDuration < LONG_PRESS_TIME) {
-          // PULSACIÓN CORTA: Navegar hacia abajo (cíclico)
-          shopMenuOption++;
-          if (shopMenuOption >= totalShopItems) shopMenuOption = 0;
-          menuOpenTime = millis();
-          delay(50);
-        } else {
-          // PULSACIÓN LARGA: Seleccionar (comprar)
-        bool bought = false;
-        bool insufficient = false;
-        
-        // Mapear la opción seleccionada al item real
-        int realItem = shopMenuOption;
-        if (shopMenuOption >= 4) {
-          // Estamos en la zona de juegos
-          if (!pet.getMemoryGameUnlocked()) {
-            // Si memoria no está desbloqueado, item 4 = memoria
-            if (shopMenuOption == 4) {
-              bought = pet.buyMemoryGame();
-            } else if (shopMenuOption == 5) {
-              // Item 5 = tres en raya
-              bought = pet.buyTicTacToeGame();
-            }
-          } else {
-            // Si memoria ya está desbloqueado, item 4 = tres en raya
-            if (shopMenuOption == 4) {
-              bought = pet.buyTicTacToeGame();
-            }
+      // Mapear la opción seleccionada al item real
+      if (shopMenuOption >= 4) {
+        // Estamos en la zona de juegos
+        if (!pet.getMemoryGameUnlocked()) {
+          // Si memoria no está desbloqueado, item 4 = memoria
+          if (shopMenuOption == 4) {
+            bought = pet.buyMemoryGame();
+          } else if (shopMenuOption == 5) {
+            // Item 5 = tres en raya
+            bought = pet.buyTicTacToeGame();
           }
         } else {
-          // Comida (items 0-3)
-          bought = pet.buyFood(shopMenuOption);
-        }
-        
-        if (!bought) { 
-          playSound(150, 50); 
-          insufficient = true; 
-        } else {
-          // Si compra exitosa, cerrar tienda y dejar que la animación happy se gestione en el loop
-          pet.showInsufficientCoins = false;
-          showShopMenu = false;
-        }
-        
-        menuOpenTime = millis();
-        if (bought && shopMenuOption >= 4) {
-          shopMenuOption = 0;
-        }
-        if (insufficient) {
-          pet.showInsufficientCoins = true;
-          pet.insufficientCoinsTimer = millis();
-        }
-          delay(100);
+          // Si memoria ya está desbloqueado, item 4 = tres en raya
+          if (shopMenuOption == 4) {
+            bought = pet.buyTicTacToeGame();
+          }
         }
+      } else {
+        // Comida (items 0-3)
+        bought = pet.buyFood(shopMenuOption);
       }
       
-        displayMgr.showShopMenuScreen(shopMenuOption);
-        if (millis() - menuOpenTime > MENU_TIMEOUT) {
-          showShopMenu = false;
-        }
-      } // Fin del else de controles de tienda
-    } else if (pet.showInsufficientCoins) {
-      // Mostrar mensaje de monedas insuficientes (sin estar en tienda)
-      displayMgr.showInsufficientCoinsScreen();
-    } else if (pet.isSleeping) {
-      // Mostrar pantalla de sueño
-      displayMgr.showSleepScreen();
-    } else if (inGame) {
-      updateGame();
-    } else if (inMemoryGame) {
-      updateMemoryGame();
-    } else if (inTicTacToe) {
-      updateTicTacToe();
-    } else if (showGameMenu) {
-      displayMgr.showGameMenuScreen(gameMenuOption);
-      // Cerrar menú si pasó mucho tiempo
-      if (millis() - menuOpenTime > MENU_TIMEOUT) {
-        showGameMenu = false;
-      }
-    } else if (showMenu) {
-      displayMgr.showMenuScreen(menuOption, soundEnabled);
-      // Cerrar menú si pasó mucho tiempo
-      if (millis() - menuOpenTime > MENU_TIMEOUT) {
-        showMenu = false;
+      menuOpenTime = event.at;
+      if (!bought) {
+        playSound(150, 50);
+        pet.showInsufficientCoins = true;
+        pet.insufficientCoinsTimer = event.at;
+      } else {
+        // Compra exitosa: cerrar tienda; la cara feliz interrumpe a la vista normal
+        pet.showInsufficientCoins = false;
+        goToScene(SCENE_MAIN);
       }
-  } else {
-    displayMgr.showMainScreen();
+    }
   }
-}
-
-if (currentTime - lastHeartbeat >= 2000) {
-    lastHeartbeat = currentTime;
-    log_i("Stats - H:%d%% B:%d%% S:%d%% Coins:%d", 
-          pet.getHunger(), pet.getBoredom(), pet.getSleepiness(), pet.getCoins());
+  
+  void update(unsigned long now) override {
+    if (now - menuOpenTime > MENU_TIMEOUT) {
+      goToScene(SCENE_MAIN);
+    }
   }
   
-  // Sin delay, máxima fluidez
-}
+  void render() override { displayMgr.showShopMenuScreen(shopMenuOption); }
+  unsigned long frameInterval() const override { return FRAME_MS_MENU; }
+};
 
-void handleButtons() {
-  // Si está durmiendo, pulsación larga lo despierta
-  if (pet.isSleeping) {
-    static bool sleepBtnPressed = false;
-    static unsigned long sleepBtnPressTime = 0;
-    
-    bool currentEnterState = digitalRead(BTN_ENTER);
-    
-    if (!sleepBtnPressed && currentEnterState == LOW) {
-      sleepBtnPressed = true;
-      sleepBtnPressTime = millis();
+// Juego de esquivar - SOLO BOTÓN CENTRO
+class DodgeScene : public Scene {
+public:
+  DodgeScene() : Scene("dodge") {}
+  
+  void enter(unsigned long now) override { startGame(now); }
+  
+  void input(const ButtonEvent& event) override {
+    // Cambiar de carril al pulsar: el rebote ya lo filtra el decodificador
+    if (event.type == BUTTON_DOWN) {
+      game.toggleLane();
     }
-    
-    if (sleepBtnPressed && currentEnterState == HIGH) {
-      unsigned long pressDuration = millis() - sleepBtnPressTime;
-      sleepBtnPressed = false;
+  }
+  
+  void update(unsigned long now) override {
+    // Tick fijo: la velocidad de las cajas no depende del ritmo de loop().
+    // Si un frame se retrasó se recuperan los ticks pendientes (con límite);
+    // los que pasen del límite se descartan sin salirse de la rejilla de ticks
+    int ticks = 0;
+    while (now - gameTickTime >= FRAME_MS_DODGE) {
+      gameTickTime += FRAME_MS_DODGE;
+      if (++ticks > 4) {
+        gameTickTime += (now - gameTickTime) / FRAME_MS_DODGE * FRAME_MS_DODGE;
+        break;
+      }
+      game.update();
       
-      if (pressDuration >= LONG_PRESS_TIME) {
-        pet.wakeUp();
-        delay(100);
+      // Detectar colisión en cada tick para no atravesar cajas al recuperar
+      if (game.checkCollision()) {
+        endGame(now);
+        return;
       }
     }
-    return;
   }
   
-  if (inGame) {
-    // Controles del juego de esquivar - SOLO BOTÓN CENTRO
-    static bool lastGameEnterState = HIGH;
-    bool currentGameEnterState = digitalRead(BTN_ENTER);
-    
-    // Detectar pulsación del botón (al soltar para evitar múltiples cambios)
-    if (lastGameEnterState == LOW && currentGameEnterState == HIGH) {
-      game.toggleLane();
-      delay(100);  // Debounce
-    }
-    
-    lastGameEnterState = currentGameEnterState;
-  } else if (inMemoryGame) {
-    // Controles del juego de memoria - SOLO BOTÓN CENTRO
-    // Variables estáticas para medir duración de pulsación
-    static bool memoryButtonPressed = false;
-    static unsigned long memoryButtonPressTime = 0;
-    
-    bool currentEnterState = digitalRead(BTN_ENTER);
-    
-    // Detectar cuando se PULSA el botón
-    if (!memoryButtonPressed && currentEnterState == LOW) {
-      memoryButtonPressed = true;
-      memoryButtonPressTime = millis();
-      memoryGame.registerButtonPress();
-      delay(50);  // Debounce
-    }
-    
-    // Detectar cuando se SUELTA el botón
-    if (memoryButtonPressed && currentEnterState == HIGH) {
-      unsigned long pressDuration = millis() - memoryButtonPressTime;
-      memoryButtonPressed = false;
+  void render() override { displayMgr.showGameScreen(&game); }
+  unsigned long frameInterval() const override {
+    return pacedFrameInterval(FRAME_MS_DODGE, display.getFlushEstimate());
+  }
+};
+
+// Juego de memoria - SOLO BOTÓN CENTRO
+class MemoryScene : public Scene {
+private:
+  bool skipPressed;  // Pulsación usada para saltar la secuencia
+  int lastLevel;
+  
+public:
+  MemoryScene() : Scene("memory"), skipPressed(false), lastLevel(-1) {}
+  
+  void enter(unsigned long now) override { startMemoryGame(now); }
+  
+  void input(const ButtonEvent& event) override {
+    if (event.type == BUTTON_DOWN) {
+      // Durante la secuencia, pulsar la salta y pasa directamente a repetir
+      skipPressed = (memoryGame.getState() == MGS_SHOWING_SEQUENCE);
+      if (skipPressed) {
+        cancelTimeline();
+        memoryGame.startWaitingInput();
+      } else {
+        memoryGame.registerButtonPress();
+      }
+    } else if (event.type == BUTTON_UP) {
+      if (skipPressed) {
+        skipPressed = false;
+        return;
+      }
       
-      // Registrar el símbolo según la duración
-      memoryGame.registerButtonRelease(pressDuration);
+      // Registrar el símbolo según la duración real (hora de los flancos)
+      memoryGame.registerButtonRelease(event.duration);
       
       // Reproducir el mismo pitido que en la secuencia
-      if (pressDuration < 400) {
+      if (event.duration < 400) {
         // Punto: pitido corto
         playSound(1000, 100);
       } else {
         // Raya: pitido largo
         playSound(800, 300);
       }
-      
-      delay(100);
     }
-  } else if (inTicTacToe) {
-    // Controles del juego de tres en raya - SOLO BOTÓN CENTRO
-    static bool ticTacBtnPressed = false;
-    static unsigned long ticTacBtnPressTime = 0;
-    
-    bool currentEnterState = digitalRead(BTN_ENTER);
+  }
+  
+  void update(unsigned long now) override {
+    memoryGame.update();
     
-    // Detectar cuando se PULSA el botón
-    if (!ticTacBtnPressed && currentEnterState == LOW) {
-      ticTacBtnPressed = true;
-      ticTacBtnPressTime = millis();
-    }
+    MemoryGameState state = memoryGame.getState();
+    int currentLevel = memoryGame.getLevel();
     
-    // Detectar cuando se SUELTA el botón
-    if (ticTacBtnPressed && currentEnterState == HIGH) {
-      unsigned long pressDuration = millis() - ticTacBtnPressTime;
-      ticTacBtnPressed = false;
-      
-      if (pressDuration < LONG_PRESS_TIME) {
-        // PULSACIÓN CORTA: Mover cursor
-        ticTacToeGame.moveCursor();
-        playBeep();
-      } else {
-        // PULSACIÓN LARGA: Colocar ficha
-        if (ticTacToeGame.tryPlacePiece()) {
-          playSound(800, 150);
-        } else {
-          playSound(200, 100);  // Error: casilla ocupada
-        }
-      }
-      
-      delay(100);
+    // Detectar avance de nivel
+    if (lastLevel >= 0 && currentLevel > lastLevel) {
+      // Nivel completado! Sonido de éxito y secuencia nueva
+      log_i("Level up! New level: %d", currentLevel);
+      memoryGame.startShowingSequence();
+      scheduleMemorySequence(true, now);
+      state = MGS_SHOWING_SEQUENCE;
     }
-  } else if (showGameMenu) {
-    // Controles del submenú de juegos - Pulsación corta navega, larga selecciona
-    // Calcular total de juegos disponibles
-    int totalGames = 1; // Siempre hay esquivar
-    if (pet.getMemoryGameUnlocked()) totalGames++; // +1 si memoria desbloqueado
-    if (pet.getTicTacToeUnlocked()) totalGames++; // +1 si tres en raya desbloqueado
-    
-    static bool gameMenuBtnPressed = false;
-    static unsigned long gameMenuBtnPressTime = 0;
     
-    bool currentEnterState = digitalRead(BTN_ENTER);
+    lastLevel = currentLevel;
     
-    // Detectar cuando se presiona
-    if (!gameMenuBtnPressed && currentEnterState == LOW) {
-      gameMenuBtnPressed = true;
-      gameMenuBtnPressTime = millis();
+    if (state == MGS_GAME_OVER) {
+      lastLevel = -1;  // Reset para próximo juego
+      endMemoryGame(now);
+      return;
     }
     
-    // Detectar cuando se suelta
-    if (gameMenuBtnPressed && currentEnterState == HIGH) {
-      unsigned long pressDuration = millis() - gameMenuBtnPressTime;
-      gameMenuBtnPressed = false;
-      
-      if (pressDuration < LONG_PRESS_TIME) {
-        // PULSACIÓN CORTA: Navegar hacia abajo
-        gameMenuOption++;
-        if (gameMenuOption >= totalGames) gameMenuOption = 0;
-        menuOpenTime = millis();
-        delay(50);
+    // Secuencia en curso: avanzar la línea de tiempo sin bloquear
+    if (state == MGS_SHOWING_SEQUENCE) {
+      if (timeline.isRunning(now)) {
+        runTimeline(now);
       } else {
-        // PULSACIÓN LARGA: Seleccionar juego
-        log_i("Game menu: Selected option %d", gameMenuOption);
-        bool success = pet.play();
-        log_i("pet.play() returned: %d (coins: %d)", success, pet.getCoins());
-        if (success) {
-          showGameMenu = false;
-          
-          // Mapear la opción a juego real
-          if (gameMenuOption == 0) {
-            log_i("Starting dodge game...");
-            startGame();
-          } else if (gameMenuOption == 1) {
-            // Item 1 puede ser memoria o tres en raya
-            if (pet.getMemoryGameUnlocked()) {
-              log_i("Starting memory game...");
-              startMemoryGame();
-            } else if (pet.getTicTacToeUnlocked()) {
-              log_i("Starting tic-tac-toe...");
-              startTicTacToe();
-            }
-          } else if (gameMenuOption == 2) {
-            // Item 2 solo existe si memoria está desbloqueado
-            if (pet.getTicTacToeUnlocked()) {
-              log_i("Starting tic-tac-toe...");
-              startTicTacToe();
-            }
-          }
-        } else {
-          log_i("Not enough coins to play!");
-          playSound(150, 50);
-          showGameMenu = false;
-        }
-        delay(100);
+        memoryGame.startWaitingInput();
       }
     }
-  } else if (showMenu) {
-    // Controles del menú principal - Pulsación corta navega, larga selecciona
-    static bool mainMenuBtnPressed = false;
-    static unsigned long mainMenuBtnPressTime = 0;
-    
-    bool currentEnterState = digitalRead(BTN_ENTER);
-    
-    // Detectar cuando se presiona
-    if (!mainMenuBtnPressed && currentEnterState == LOW) {
-      mainMenuBtnPressed = true;
-      mainMenuBtnPressTime = millis();
+  }
+  
+  void render() override {
+    if (memoryGame.getState() == MGS_SHOWING_SEQUENCE) {
+      drawTimeline();
+      return;
     }
-    
-    // Detectar cuando se suelta
-    if (mainMenuBtnPressed && currentEnterState == HIGH) {
-      unsigned long pressDuration = millis() - mainMenuBtnPressTime;
-      mainMenuBtnPressed = false;
-      
-      if (pressDuration < LONG_PRESS_TIME) {
-        // PULSACIÓN CORTA: Navegar hacia abajo
-        menuOption++;
-        if (menuOption > 3) menuOption = 0;
-        menuOpenTime = millis();
-        delay(50);
+    displayMgr.showMemoryGameScreen(&memoryGame);
+  }
+  
+  unsigned long frameInterval() const override { return eyesFrameInterval(); }
+};
+
+// Tres en raya - SOLO BOTÓN CENTRO
+class TicTacToeScene : public Scene {
+public:
+  TicTacToeScene() : Scene("tictactoe") {}
+  
+  void enter(unsigned long now) override { startTicTacToe(); }
+  
+  void input(const ButtonEvent& event) override {
+    if (event.type == BUTTON_SHORT_PRESS) {
+      // PULSACIÓN CORTA: Mover cursor
+      ticTacToeGame.moveCursor();
+      playBeep();
+    } else if (event.type == BUTTON_LONG_PRESS) {
+      // PULSACIÓN LARGA: Colocar ficha
+      if (ticTacToeGame.tryPlacePiece()) {
+        playSound(800, 150);
       } else {
-        // PULSACIÓN LARGA: Seleccionar acción
-        bool success = false;
-        switch(menuOption) {
-          case 0: // TIENDA
-            showMenu = false;
-            showShopMenu = true;
-            shopMenuOption = 0;
-            menuOpenTime = millis();
-            playSound(200, 100);
-            break;
-          case 1: // JUGAR
-            showMenu = false;
-            showGameMenu = true;
-            gameMenuOption = 0;
-            menuOpenTime = millis();
-            playSound(150, 100);
-            break;
-          case 2: // DORMIR
-            success = pet.sleep();
-            if (success) {
-              playSound(200, 50);
-            } else {
-              playSound(150, 50);
-            }
-            showMenu = false;
-            break;
-          case 3: // SOUND
-            soundEnabled = !soundEnabled;
-            soundPrefs.putBool("enabled", soundEnabled);
-            menuOpenTime = millis();
-            break;
-        }
-        delay(100);
+        playSound(200, 100);  // Error: casilla ocupada
       }
     }
-  } else {
-    // Vista normal - solo ojos visible - Cualquier pulsación abre menú
-    static bool mainScreenBtnPressed = false;
-    
-    bool currentEnterState = digitalRead(BTN_ENTER);
+  }
+  
+  void update(unsigned long now) override {
+    // Actualizar lógica del juego (IA del Tamagotchi)
+    ticTacToeGame.update();
     
-    // Detectar cuando se presiona
-    if (!mainScreenBtnPressed && currentEnterState == LOW) {
-      mainScreenBtnPressed = true;
+    // Comprobar si el juego ha terminado
+    if (ticTacToeGame.getState() == TIC_GAME_OVER) {
+      showFinalBoard(now);
     }
-    
-    // Detectar cuando se suelta
-    if (mainScreenBtnPressed && currentEnterState == HIGH) {
-      mainScreenBtnPressed = false;
-      
-      // Abrir menú con cualquier pulsación
-      showMenu = true;
-      menuOpenTime = millis();
-      menuOption = 0;
-      playSound(150, 100);
-      delay(100);
+  }
+  
+  void render() override { displayMgr.showTicTacToeScreen(&ticTacToeGame); }
+  unsigned long frameInterval() const override { return FRAME_MS_MENU; }
+};
+
+// Cara enfadada o feliz de la mascota (superpone todo y bloquea botones)
+class FaceScene : public Scene {
+private:
+  bool angrySoundPlayed;
+  bool happySoundPlayed;
+  
+public:
+  FaceScene() : Scene("face"), angrySoundPlayed(false), happySoundPlayed(false) {}
+  
+  void update(unsigned long now) override {
+    // Mostrará los ojos en modo ANGRY o HAPPY; cada sonido una vez por cara
+    if (pet.showAngryFace) {
+      if (!angrySoundPlayed) {
+        playAngrySound();
+        angrySoundPlayed = true;
+      }
+    } else {
+      if (!happySoundPlayed) {
+        playHappySound();
+        happySoundPlayed = true;
+      }
+      angrySoundPlayed = false;
     }
   }
+  
+  void exit() override {
+    angrySoundPlayed = false;
+    happySoundPlayed = false;
+  }
+  
+  void render() override { displayMgr.showMainScreen(); }
+  unsigned long frameInterval() const override { return eyesFrameInterval(); }
+};
+
+// Mensaje de monedas insuficientes (sin aceptar controles)
+class NoCoinsScene : public Scene {
+public:
+  NoCoinsScene() : Scene("nocoins") {}
+  void render() override { displayMgr.showInsufficientCoinsScreen(); }
+  unsigned long frameInterval() const override { return FRAME_MS_MENU; }
+};
+
+// Durmiendo: pulsación larga lo despierta. loop() hace light sleep entre ticks
+class SleepScene : public Scene {
+public:
+  SleepScene() : Scene("sleep") {}
+  
+  void input(const ButtonEvent& event) override {
+    if (event.type == BUTTON_LONG_PRESS) {
+      pet.wakeUp();
+    }
+  }
+  
+  void render() override { displayMgr.showSleepScreen(); }
+  unsigned long frameInterval() const override { return FRAME_MS_MENU; }
+};
+
+MainScene mainScene;
+MenuScene menuScene;
+GameMenuScene gameMenuScene;
+ShopScene shopScene;
+DodgeScene dodgeScene;
+MemoryScene memoryScene;
+TicTacToeScene ticTacToeScene;
+FaceScene faceScene;
+NoCoinsScene noCoinsScene;
+SleepScene sleepScene;
+TimedOverlay gameOverScene("gameover"); // Fin de partida de cualquier juego
+
+void goToScene(SceneId id) {
+  switch (id) {
+    case SCENE_MAIN: scheduler.setScene(&mainScene); break;
+    case SCENE_MENU: scheduler.setScene(&menuScene); break;
+    case SCENE_GAME_MENU: scheduler.setScene(&gameMenuScene); break;
+    case SCENE_SHOP: scheduler.setScene(&shopScene); break;
+    case SCENE_DODGE: scheduler.setScene(&dodgeScene); break;
+    case SCENE_MEMORY: scheduler.setScene(&memoryScene); break;
+    case SCENE_TICTACTOE: scheduler.setScene(&ticTacToeScene); break;
+    case SCENE_GAME_OVER: scheduler.setScene(&gameOverScene); break;
+  }
 }
 
-void startGame() {
-  log_i("=== STARTING DODGE GAME ===");
-  inGame = true;
-  gameStartTime = millis();
-  game.reset();
-  playSound(400, 100);
-  log_i("Dodge game started. inGame=%d", inGame);
+// Ojos animados: el intervalo de la escena se alarga si el bus no da para más
+unsigned long eyesFrameInterval() {
+  return pacedFrameInterval(FRAME_MS_EYES, display.getFlushEstimate());
+}
+
+// ==================== TAREAS DE FONDO ====================
+
+void petTaskRun(unsigned long now) {
+  pet.update();
+}
+
+// Reproducir sonidos de estado bajo (hambre, aburrimiento, sueño)
+void alertTaskRun(unsigned long now) {
+  if (pet.playHungrySound) {
+    playAngrySound(AUDIO_PRIORITY_ALERT);
+    pet.playHungrySound = false;
+  }
+  if (pet.playBoredSound) {
+    playBoredSound();
+    pet.playBoredSound = false;
+  }
+  if (pet.playSleepySound) {
+    playSleepySound();
+    pet.playSleepySound = false;
+  }
+}
+
+void audioTaskRun(unsigned long now) {
+  audio.update(now);
+}
+
+// Sin tarea de persistencia (host) el lote pendiente se escribe desde aquí
+void storageTaskRun(unsigned long now) {
+  storage.update(now);
+}
+
+// Las escenas de la mascota, por prioridad, interrumpen a la escena actual
+void focusTaskRun(unsigned long now) {
+  if (pet.showAngryFace || pet.showHappyFace) {
+    scheduler.interrupt(&faceScene);
+  } else if (pet.showInsufficientCoins) {
+    scheduler.interrupt(&noCoinsScene);
+  } else if (pet.isSleeping) {
+    scheduler.interrupt(&sleepScene);
+  } else {
+    scheduler.interrupt(nullptr);
+  }
+}
+
+void statsTaskRun(unsigned long now) {
+  log_i("Stats - H:%d%% B:%d%% S:%d%% Coins:%d", 
+        pet.getHunger(), pet.getBoredom(), pet.getSleepiness(), pet.getCoins());
+  log_i("Display - Frames:%lu Pages:%lu Bytes:%lu Cmd:%lu Waits:%lu Deferred:%lu",
+        display.getFramesFlushed(), display.getPagesFlushed(),
+        display.getBytesSent(), display.getCommandBytesSent(),
+        display.getFlushWaits(), displayMgr.getDeferredFrames());
+  log_i("Power - LightSleeps:%lu Slept:%lums", power.getSleepCount(), power.getSleptMillis());
+  log_i("Audio - Notes:%lu Preempted:%lu Dropped:%lu",
+        audio.getNotesPlayed(), audio.getPreemptions(), audio.getDropped());
+  log_i("Input - Overflows:%lu", button.getOverflows());
+  log_i("Storage - Batches:%lu Writes:%lu Skipped:%lu Dropped:%lu",
+        storage.getBatches(), storage.getWrites(), storage.getSkipped(), storage.getDropped());
+  log_i("Frames - Total:%lu Skipped:%lu Missed:%lu Load:%lu%%",
+        governor.getFrames(), governor.getSkippedFrames(),
+        governor.getMissedDeadlines(), governor.getLoadPercent());
+  logPacing(now);
+  log_i("Sprites - Hits:%lu Misses:%lu",
+        display.getRoundRectCache().getHits(), display.getRoundRectCache().getMisses());
+  scheduler.logStats();
 }
 
-void updateGame() {
-  game.update();
+void setup() {
+  Serial.begin(115200);
+  Serial.setDebugOutput(true);
+  unsigned long serialStart = millis();
+  while (!Serial && (millis() - serialStart < 2000)) {
+    delay(10);
+  }
+  delay(200);
+  log_i("=== TAMAGOTCHI START ===");
+  // Inicializar botón central: flancos por interrupción hacia el decodificador
+  button.begin(BTN_ENTER);
+  gestures.begin(&button);
+  scheduler.setInput(&gestures);
+  power.initialize(BTN_ENTER);  // El botón despierta la CPU del light sleep
   
-  // Mostrar pantalla del juego
-  displayMgr.showGameScreen(&game);
+  // Inicializar buzzer (LEDC y temporizador de las notas)
+  if (!audio.begin(BUZZER_PIN)) {
+    log_i("Audio engine unavailable, buzzer muted");
+  }
   
-  // Detectar colisión
-  if (game.checkCollision()) {
-    endGame();
+  // Configurar pines I2C personalizados
+  Wire.begin(I2C_SDA, I2C_SCL);
+
+  // Inicializar display OLED
+  if (!display.begin(SSD1306_SWITCHCAPVCC, 0x3C)) {
+    log_i("SSD1306 allocation failed");
+    for (;;);
   }
+  
+  // Transmitir los frames en segundo plano mientras loop() dibuja el siguiente
+  if (!display.beginAsync(RENDER_TASK_PRIORITY)) {
+    log_i("OLED async flush unavailable, using blocking display()");
+  }
+  
+  display.clearDisplay();
+  display.setTextSize(1);
+  display.setTextColor(SSD1306_WHITE);
+  display.setCursor(0, 0);
+  display.println("Tamagotchi Init...");
+  display.display();
+  
+#ifdef ARDUINO_ARCH_ESP32
+  // loop() corre en loopTask: por encima del envío y de la flash, el botón
+  // y la lógica nunca esperan a que terminen
+  vTaskPrioritySet(NULL, LOGIC_TASK_PRIORITY);
+#endif
+  
+  // Escrituras en NVS en una tarea de baja prioridad, agrupadas por lotes
+  if (!storage.begin(STORAGE_TASK_PRIORITY)) {
+    log_i("Storage task unavailable, writing batches from loop()");
+  }
+  
+  // Inicializar tamagotchi
+  pet.initialize();
+  
+  // Inicializar juego
+  game.initialize();
+  
+  // Inicializar juego de memoria
+  memoryGame.initialize();
+  
+  // Inicializar juego de tres en raya
+  ticTacToeGame.initialize();
+  
+  // Inicializar display manager
+  displayMgr.initialize(&display, &pet);
+  
+  // Cargar configuración de sonido
+  Preferences soundPrefs;
+  soundPrefs.begin("sound", true); // Solo lectura
+  soundEnabled = soundPrefs.getBool("enabled", true); // Por defecto ON
+  soundPrefs.end();
+  audio.setEnabled(soundEnabled);
+  
+#ifdef RENDER_BENCHMARK
+  // Medir el coste de cada pantalla y mostrarlo por el puerto serie
+  RenderBenchmark bench(&display, &displayMgr);
+  bench.run(&Serial);
+#endif
+  
+  // Tareas de fondo (en este orden en cada tick) y escena inicial
+  unsigned long now = millis();
+  petTask = scheduler.addTask("pet", petTaskRun, PET_TASK_MS, now);
+  scheduler.addTask("alerts", alertTaskRun, 0, now);
+  scheduler.addTask("audio", audioTaskRun, 0, now);
+  scheduler.addTask("storage", storageTaskRun, 0, now);
+  scheduler.addTask("focus", focusTaskRun, 0, now);
+  scheduler.addTask("stats", statsTaskRun, STATS_TASK_MS, now);
+  goToScene(SCENE_MAIN);
+  
+  log_i("Tamagotchi initialized successfully!");
 }
 
-void endGame() {
-  inGame = false;
+void loop() {
+  governor.beginFrame();
+  scheduler.tick(millis());
+  
+  // Enviar el frame completo (ojos, overlays y juegos) en un único display()
+  // salvo que el governor lo descarte por ir con retraso
+  if (governor.shouldPresent()) {
+    displayMgr.commitFrame();
+  }
   
+  // Durmiendo no hay nada que animar: light sleep hasta que la mascota
+  // tenga que procesar el siguiente tick de sueño o hasta que se pulse el botón.
+  // Con una nota sonando se espera: el LEDC se detiene en light sleep.
+  // Si el botón lo acaba de despertar la escena cambia en el siguiente tick:
+  // no hay que volver a dormir
+  if (scheduler.getActiveScene() == &sleepScene && pet.getIsSleeping() && !audio.isPlaying()) {
+    unsigned long wakeAt = max(pet.getNextSleepTick(), scheduler.getNextRun(petTask));
+    SleepResult slept = SLEEP_SKIPPED;
+    if ((long)(wakeAt - millis()) > 0 && power.canSleep(wakeAt - millis())) {
+      // El último frame pudo quedar aplazado: enviarlo antes de dormir.
+      // Solo aquí se espera al bus, nunca mientras se mantiene el botón
+      display.waitForFlush();
+      displayMgr.commitFrame();
+      display.waitForFlush();
+      unsigned long now = millis();
+      if ((long)(wakeAt - now) > 0) {
+        button.suspend();
+        slept = power.lightSleep(wakeAt - now);
+        button.resume();
+      }
+    }
+    // Si no llegó a dormir (botón pulsado, poco margen) se sigue como un
+    // frame normal: loop() tiene la prioridad más alta y tiene que ceder la
+    // CPU en endFrame() para que el envío, la persistencia e IDLE avancen
+    if (slept != SLEEP_SKIPPED) {
+      governor.resync();
+      return;
+    }
+  }
+  
+  // Ceder la CPU hasta completar el presupuesto de frame de la escena
+  governor.setInterval(scheduler.getActiveScene()->frameInterval());
+  governor.endFrame();
+}
+
+// FPS que llegan de verdad al panel, frames descartados y ocupación del bus
+// desde el informe anterior
+void logPacing(unsigned long now) {
+  static unsigned long lastReport = 0;
+  static unsigned long lastSent = 0;
+  static unsigned long lastBus = 0;
+  static unsigned long lastSkipped = 0;
+  
+  unsigned long window = now - lastReport;
+  if (window == 0) return;
+  unsigned long sent = display.getFramesSent() - lastSent;
+  unsigned long bus = display.getBusMicros() - lastBus;
+  log_i("Pacing - FPS:%lu.%lu Dropped:%lu Bus:%lu%% Flush:%luus Interval:%lums",
+        sent * 1000 / window, (sent * 10000 / window) % 10,
+        governor.getSkippedFrames() - lastSkipped, bus / (window * 10),
+        display.getFlushEstimate(), governor.getInterval());
+  
+  lastReport = now;
+  lastSent = display.getFramesSent();
+  lastBus = display.getBusMicros();
+  lastSkipped = governor.getSkippedFrames();
+}
+
+void startGame(unsigned long now) {
+  log_i("=== STARTING DODGE GAME ===");
+  gameTickTime = now;
+  game.reset();
+  playSound(400, 100);
+  log_i("Dodge game started");
+}
+
+void endGame(unsigned long now) {
   // Guardar récord si se ha superado
   game.saveRecord();
   
@@ -654,125 +875,107 @@ void endGame() {
   pet.addBoredom(coinsEarned);
   
   // Mostrar pantalla de game over durante 3 segundos
-  unsigned long gameOverStart = millis();
-  while (millis() - gameOverStart < 3000) {
-    displayMgr.showGameOver(&game, coinsEarned);
-    delay(10);
-  }
-  
-  // DESPUÉS de los 3 segundos, activar animación HAPPY
+  gameOverCoins = coinsEarned;
+  gameOverScene.show(now, drawGameOver, GAME_OVER_TIME, true, finishGame);
+  goToScene(SCENE_GAME_OVER);
+}
+
+void drawGameOver() {
+  displayMgr.showGameOver(&game, gameOverCoins);
+}
+
+void finishGame() {
+  // DESPUÉS de la pantalla de game over, activar animación HAPPY
   pet.showHappyFace = true;
   pet.happyFaceTimer = millis();
+  goToScene(SCENE_MAIN);
   
   // Nota: La animación happy se gestionará en el loop principal
 }
 
-void startMemoryGame() {
+void startMemoryGame(unsigned long now) {
   log_i("=== STARTING MEMORY GAME ===");
-  inMemoryGame = true;
-  gameStartTime = millis();
   memoryGame.reset();
-  playSound(800, 150);
-  
-  // Pequeña pausa antes de empezar
-  delay(500);
   
-  // Mostrar la secuencia inicial
+  // Mostrar la secuencia inicial con ojos y sonidos; MemoryScene::update()
+  // la avanza con runTimeline() en cada frame y al terminar pasa a esperar
+  // la respuesta
   memoryGame.startShowingSequence();
+  scheduleMemorySequence(false, now);
+  
+  log_i("Memory game started. Sequence length: %d", memoryGame.getSequenceLength());
+}
+
+// Programa en la línea de tiempo la secuencia de la partida (con el sonido
+// de éxito delante si se acaba de pasar de nivel). Mismos tiempos que la
+// versión con delay(): 620 ms por punto y 1020 ms por raya.
+void scheduleMemorySequence(bool levelUp, unsigned long now) {
+  timeline.clear();
+  uint16_t t = 0;
+  
+  if (levelUp) {
+    // Sonido de éxito
+    timeline.add(t, TL_EYE_POSE, EYE_POSE_NORMAL);
+    timeline.add(t, TL_TONE, 1500, 100);
+    timeline.add(t + 320, TL_TONE, 1800, 100);
+    t += 940;
+  } else {
+    // Sonido de inicio y pequeña pausa antes de empezar
+    timeline.add(t, TL_TEXT, LABEL_OBSERVA);
+    timeline.add(t, TL_TONE, 800, 150);
+    t += 670;
+  }
   
-  // Reproducir la secuencia con ojos y sonidos
   const int* sequence = memoryGame.getSequence();
   int seqLength = memoryGame.getSequenceLength();
-  
   for (int i = 0; i < seqLength; i++) {
     if (sequence[i] == MORSE_DOT) {
       // PUNTO: parpadeo rápido + pitido corto
-      displayMgr.showEyesBlink();
-      playSound(1000, 100);  // Pitido corto y agudo
-      delay(200);
-      displayMgr.showEyesNormal();
-      delay(300);  // Pausa entre símbolos
+      timeline.add(t, TL_EYE_POSE, EYE_POSE_BLINK);
+      timeline.add(t, TL_TONE, 1000, 100);
+      timeline.add(t + 320, TL_EYE_POSE, EYE_POSE_NORMAL);
+      t += 620;
     } else {
       // RAYA: parpadeo lento + pitido largo
-      displayMgr.showEyesBlink();
-      delay(100);
-      playSound(800, 300);  // Pitido largo y grave
-      delay(200);
-      displayMgr.showEyesNormal();
-      delay(400);  // Pausa más larga
+      timeline.add(t, TL_EYE_POSE, EYE_POSE_BLINK);
+      timeline.add(t + 100, TL_TONE, 800, 300);
+      timeline.add(t + 620, TL_EYE_POSE, EYE_POSE_NORMAL);
+      t += 1020;
     }
   }
   
-  // Mostrar pantalla "REPITE"
-  delay(500);
-  memoryGame.startWaitingInput();
-  
-  log_i("Memory game started. Sequence length: %d", seqLength);
+  // Pausa antes de mostrar "REPITE"
+  timeline.setLength(t + 500);
+  timeline.start(now);
 }
 
-void updateMemoryGame() {
-  static int lastLevel = -1;
-  
-  memoryGame.update();
-  
-  MemoryGameState state = memoryGame.getState();
-  int currentLevel = memoryGame.getLevel();
-  
-  // Detectar avance de nivel
-  if (lastLevel >= 0 && currentLevel > lastLevel) {
-    // Nivel completado! Mostrar secuencia nueva
-    log_i("Level up! New level: %d", currentLevel);
-    
-    // Pequeña pausa y sonido de éxito
-    displayMgr.showEyesNormal();
-    playSound(1500, 100);
-    delay(200);
-    playSound(1800, 100);
-    delay(500);
-    
-    // Mostrar la nueva secuencia
-    memoryGame.startShowingSequence();
-    const int* sequence = memoryGame.getSequence();
-    int seqLength = memoryGame.getSequenceLength();
-    
-    for (int i = 0; i < seqLength; i++) {
-      if (sequence[i] == MORSE_DOT) {
-        // PUNTO: parpadeo rápido + pitido corto
-        displayMgr.showEyesBlink();
-        playSound(1000, 100);
-        delay(200);
-        displayMgr.showEyesNormal();
-        delay(300);
-      } else {
-        // RAYA: parpadeo lento + pitido largo
-        displayMgr.showEyesBlink();
-        delay(100);
-        playSound(800, 300);
-        delay(200);
-        displayMgr.showEyesNormal();
-        delay(400);
-      }
+// Aplica los eventos vencidos de la línea de tiempo
+void runTimeline(unsigned long now) {
+  TimelineEvent event;
+  while (timeline.poll(now, event)) {
+    if (event.type == TL_TONE) {
+      audio.playTone(event.value, event.duration, AUDIO_PRIORITY_FEEDBACK);
     }
-    
-    delay(500);
-    memoryGame.startWaitingInput();
   }
-  
-  lastLevel = currentLevel;
-  
-  if (state == MGS_GAME_OVER) {
-    lastLevel = -1;  // Reset para próximo juego
-    endMemoryGame();
-    return;
+}
+
+// Dibuja lo que toque según el último evento visual
+void drawTimeline() {
+  TimelineEvent event;
+  if (!timeline.getView(event)) return;
+  switch (event.type) {
+    case TL_EYE_POSE: displayMgr.showEyesPose(event.value); break;
+    case TL_EYE_MOOD: displayMgr.showEyesMood(event.value); break;
+    case TL_TEXT: displayMgr.showCaption((TextLabel)event.value); break;
   }
-  
-  // Mostrar pantalla del juego de memoria
-  displayMgr.showMemoryGameScreen(&memoryGame);
 }
 
-void endMemoryGame() {
-  inMemoryGame = false;
-  
+void cancelTimeline() {
+  timeline.cancel();
+  audio.stop();
+}
+
+void endMemoryGame(unsigned long now) {
   // Calcular monedas ganadas: nivel × 3
   int finalLevel = memoryGame.getLevel();
   int coinsEarned = finalLevel * 3;
@@ -780,52 +983,52 @@ void endMemoryGame() {
   pet.addCoins(coinsEarned);
   pet.addBoredom(5);  // Pequeño aumento de diversión
   
-  // Mostrar animación HAPPY si ganó monedas
+  // Sonido de victoria si ganó monedas
   if (coinsEarned > 0) {
-    pet.showHappyFace = true;
-    pet.happyFaceTimer = millis();
-    playSound(1200, 50);
-    delay(100);
-    playSound(1200, 50);
+    static const AudioNote winNotes[] = { {1200, 100, 120}, {1200, 100, 20} };
+    audio.play(winNotes, 2, AUDIO_PRIORITY_EVENT);
   }
   
-  // Mostrar pantalla de fin de juego
-  displayMgr.showMemoryGameOver(&memoryGame, coinsEarned);
-  
-  // Esperar un momento antes de volver
-  delay(3000);
+  // Mostrar pantalla de fin de juego un momento antes de volver
+  gameOverCoins = coinsEarned;
+  gameOverScene.show(now, drawMemoryGameOver, GAME_OVER_TIME, true, finishMemoryGame);
+  goToScene(SCENE_GAME_OVER);
   
   log_i("Memory game ended. Level: %d, Coins earned: %d", finalLevel, coinsEarned);
 }
 
+void drawMemoryGameOver() {
+  displayMgr.showMemoryGameOver(&memoryGame, gameOverCoins);
+}
+
+void finishMemoryGame() {
+  // Mostrar animación HAPPY si ganó monedas
+  if (gameOverCoins > 0) {
+    pet.showHappyFace = true;
+    pet.happyFaceTimer = millis();
+  }
+  goToScene(SCENE_MAIN);
+}
+
 void startTicTacToe() {
   log_i("=== STARTING TIC-TAC-TOE ===");
-  inTicTacToe = true;
-  gameStartTime = millis();
   ticTacToeGame.reset();
   playSound(600, 150);
-  delay(300);
   
   log_i("Tic-Tac-Toe started. Player first: %d", ticTacToeGame.isPlayerFirst());
 }
 
-void updateTicTacToe() {
-  // Actualizar lógica del juego (IA del Tamagotchi)
-  ticTacToeGame.update();
-  
-  // Mostrar pantalla del juego
+// Tablero final durante la pausa antes de mostrar resultado
+void showFinalBoard(unsigned long now) {
+  gameOverScene.show(now, drawFinalBoard, BOARD_PAUSE_TIME, false, endTicTacToe);
+  goToScene(SCENE_GAME_OVER);
+}
+
+void drawFinalBoard() {
   displayMgr.showTicTacToeScreen(&ticTacToeGame);
-  
-  // Comprobar si el juego ha terminado
-  if (ticTacToeGame.getState() == TIC_GAME_OVER) {
-    delay(500);  // Pausa antes de mostrar resultado
-    endTicTacToe();
-  }
 }
 
 void endTicTacToe() {
-  inTicTacToe = false;
-  
   GameResult result = ticTacToeGame.getResult();
   int coinsEarned = 0;
   
@@ -850,21 +1053,25 @@ void endTicTacToe() {
   }
   
   // Mostrar pantalla de fin de juego durante 3 segundos
-  unsigned long gameOverStart = millis();
-  while (millis() - gameOverStart < 3000) {
-    displayMgr.showTicTacToeGameOver(&ticTacToeGame, coinsEarned);
-    delay(10);
-  }
+  gameOverCoins = coinsEarned;
+  gameOverScene.show(millis(), drawTicTacToeGameOver, GAME_OVER_TIME, true, finishTicTacToe);
+  goToScene(SCENE_GAME_OVER);
   
+  log_i("Tic-Tac-Toe ended. Result: %d, Coins earned: %d", result, coinsEarned);
+}
+
+void drawTicTacToeGameOver() {
+  displayMgr.showTicTacToeGameOver(&ticTacToeGame, gameOverCoins);
+}
+
+void finishTicTacToe() {
   // DESPUÉS de los 3 segundos, activar animación HAPPY si ganó monedas
-  if (coinsEarned > 0) {
+  if (gameOverCoins > 0) {
     pet.showHappyFace = true;
     pet.happyFaceTimer = millis();
-    playSound(1500, 100);
-    delay(100);
-    playSound(1800, 100);
+    static const AudioNote winNotes[] = { {1500, 100, 120}, {1800, 100, 20} };
+    audio.play(winNotes, 2, AUDIO_PRIORITY_EVENT);
   }
-  
-  log_i("Tic-Tac-Toe ended. Result: %d, Coins earned: %d", result, coinsEarned);
+  goToScene(SCENE_MAIN);
 }
 
@@ -8,9 +8,13 @@ MemoryGame::MemoryGame() {
   state = MGS_IDLE;
   buttonWasPressed = false;
   buttonPressStartTime = 0;
+  clock = &systemClock;
+  rng = &systemRng;
 }
 
-void MemoryGame::initialize() {
+void MemoryGame::initialize(Clock* clk, Rng* rnd) {
+  clock = clk;
+  rng = rnd;
   highScore = 0;  // Se mantiene entre partidas
   reset();
 }
@@ -39,7 +43,7 @@ void MemoryGame::update() {
 void MemoryGame::generateSequence() {
   // Generar secuencia aleatoria de puntos y rayas
   for (int i = 0; i < sequenceLength; i++) {
-    sequence[i] = random(0, 2);  // 0 = punto, 1 = raya
+    sequence[i] = rng->next(0, 2);  // 0 = punto, 1 = raya
   }
   log_i("Generated sequence of length %d for level %d", sequenceLength, level);
 }
@@ -68,7 +72,7 @@ void MemoryGame::registerButtonPress() {
   if (buttonWasPressed) return;  // Ya está presionado
   
   buttonWasPressed = true;
-  buttonPressStartTime = millis();
+  buttonPressStartTime = clock->now();
   log_i("Button pressed at %lu", buttonPressStartTime);
 }
 
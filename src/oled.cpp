@@ -0,0 +1,283 @@
+#include "oled.h"
+
+OledDisplay::OledDisplay(TwoWire* twi) : Adafruit_SSD1306(OLED_WIDTH, OLED_HEIGHT, twi, -1) {
+  memset(sentBuffer, 0, sizeof(sentBuffer));
+  memset(frontBuffer, 0, sizeof(frontBuffer));
+  fullRefreshPending = true;
+#ifdef ARDUINO_ARCH_ESP32
+  flushTask = nullptr;
+  flushIdle = nullptr;
+#endif
+  framesFlushed = 0;
+  pagesFlushed = 0;
+  bytesSent = 0;
+  commandBytesSent = 0;
+  flushWaits = 0;
+  framesSent = 0;
+  busMicros = 0;
+  flushEstimate = 0;
+  resetRenderStats();
+}
+
+bool OledDisplay::begin(uint8_t switchvcc, uint8_t i2caddr) {
+  if (!Adafruit_SSD1306::begin(switchvcc, i2caddr)) {
+    return false;
+  }
+  // El contenido de la GDDRAM es desconocido tras el arranque
+  invalidate();
+  return true;
+}
+
+void OledDisplay::invalidate() {
+  fullRefreshPending = true;
+}
+
+void OledDisplay::dim(bool dim) {
+  // El comando comparte el bus con la tarea de envío
+  waitForFlush();
+  Adafruit_SSD1306::dim(dim);
+}
+
+void OledDisplay::resetStats() {
+  framesFlushed = 0;
+  pagesFlushed = 0;
+  bytesSent = 0;
+  commandBytesSent = 0;
+  flushWaits = 0;
+  framesSent = 0;
+  busMicros = 0;
+}
+
+void OledDisplay::resetRenderStats() {
+  memset(&renderStats, 0, sizeof(renderStats));
+}
+
+#ifdef ARDUINO_ARCH_ESP32
+bool OledDisplay::beginAsync(uint8_t priority) {
+  if (flushTask != nullptr) return true;
+  
+  flushIdle = xSemaphoreCreateBinary();
+  if (flushIdle == nullptr) return false;
+  xSemaphoreGive(flushIdle);
+  
+  // Wire bloquea la tarea que transmite hasta la interrupción de fin de
+  // transferencia, así que mientras tanto la CPU queda libre para loop()
+  if (xTaskCreate(flushTaskEntry, "oled_flush", OLED_FLUSH_STACK, this, priority, &flushTask) != pdPASS) {
+    vSemaphoreDelete(flushIdle);
+    flushIdle = nullptr;
+    flushTask = nullptr;
+    return false;
+  }
+  return true;
+}
+
+bool OledDisplay::isAsync() const {
+  return flushTask != nullptr;
+}
+
+void OledDisplay::waitForFlush() {
+  if (flushTask == nullptr) return;
+  xSemaphoreTake(flushIdle, portMAX_DELAY);
+  xSemaphoreGive(flushIdle);
+}
+
+bool OledDisplay::isFlushing() {
+  return flushTask != nullptr && uxSemaphoreGetCount(flushIdle) == 0;
+}
+
+void OledDisplay::flushTaskEntry(void* arg) {
+  OledDisplay* self = (OledDisplay*)arg;
+  for (;;) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    self->transmit(self->frontBuffer);
+    xSemaphoreGive(self->flushIdle);
+  }
+}
+#else
+bool OledDisplay::beginAsync(uint8_t priority) {
+  return false;
+}
+
+bool OledDisplay::isAsync() const {
+  return false;
+}
+
+void OledDisplay::waitForFlush() {
+}
+
+bool OledDisplay::isFlushing() {
+  return false;
+}
+#endif
+
+void OledDisplay::display() {
+  framesFlushed++;
+  
+#ifdef ARDUINO_ARCH_ESP32
+  if (flushTask != nullptr) {
+    // Cambio de buffer en el límite de frame: esperar solo si el anterior sigue en curso
+    if (xSemaphoreTake(flushIdle, 0) != pdTRUE) {
+      flushWaits++;
+      xSemaphoreTake(flushIdle, portMAX_DELAY);
+    }
+    memcpy(frontBuffer, buffer, sizeof(frontBuffer));
+    xTaskNotifyGive(flushTask);
+    return;
+  }
+#endif
+  
+  transmit(buffer);
+}
+
+void OledDisplay::transmit(const uint8_t* frame) {
+  // Leer y limpiar la petición antes de enviar: un invalidate() durante el
+  // envío se aplicará al frame siguiente
+  bool fullRefresh = fullRefreshPending;
+  fullRefreshPending = false;
+  unsigned long start = micros();
+  unsigned long pagesBefore = pagesFlushed;
+  
+#if ARDUINO >= 157
+  wire->setClock(wireClk);
+#endif
+  
+  for (uint8_t page = 0; page < OLED_PAGES; page++) {
+    const uint8_t* row = frame + page * OLED_WIDTH;
+    uint8_t* sent = sentBuffer + page * OLED_WIDTH;
+    int first = 0;
+    int last = OLED_WIDTH - 1;
+    
+    if (!fullRefresh) {
+      // Página idéntica a la enviada: no hay nada que transmitir
+      if (memcmp(row, sent, OLED_WIDTH) == 0) continue;
+      
+      // Acotar la ventana de columnas modificadas
+      while (row[first] == sent[first]) first++;
+      while (row[last] == sent[last]) last--;
+    }
+    
+    sendWindow(page, first, last, row + first);
+    memcpy(sent + first, row + first, last - first + 1);
+  }
+  
+#if ARDUINO >= 157
+  wire->setClock(restoreClk);
+#endif
+  
+  // Frame sin cambios: no dice nada del coste del bus
+  if (pagesFlushed == pagesBefore) return;
+  unsigned long took = micros() - start;
+  framesSent++;
+  busMicros += took;
+  // Sube en cuanto un frame cuesta más y baja poco a poco, para que tras
+  // varios frames baratos un parpadeo no se salte el plazo
+  if (took > flushEstimate) flushEstimate = took;
+  else flushEstimate -= (flushEstimate - took) / 8;
+}
+
+void OledDisplay::sendWindow(uint8_t page, uint8_t colStart, uint8_t colEnd, const uint8_t* data) {
+  // Ventana de direccionamiento: una página y el rango de columnas modificado
+  const uint8_t window[] = {
+    SSD1306_PAGEADDR, page, page,
+    SSD1306_COLUMNADDR, colStart, colEnd
+  };
+  ssd1306_commandList(window, sizeof(window));
+  commandBytesSent += sizeof(window);
+  
+  int remaining = colEnd - colStart + 1;
+  while (remaining > 0) {
+    int chunk = min(remaining, OLED_WIRE_CHUNK);
+    wire->beginTransmission(i2caddr);
+    wire->write((uint8_t)0x40);  // Co = 0, D/C = 1: siguen datos de GDDRAM
+    wire->write(data, chunk);
+    wire->endTransmission();
+    data += chunk;
+    remaining -= chunk;
+    bytesSent += chunk;
+  }
+  
+  pagesFlushed++;
+}
+
+// ==================== RELLENOS POR SPANS ====================
+
+void OledDisplay::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+  RENDER_COUNT(this, rects, 1);
+  if (getRotation() != 0) {
+    Adafruit_SSD1306::fillRect(x, y, w, h, color);
+    return;
+  }
+  if (w > 0 && h > 0) RENDER_COUNT(this, pixels, (unsigned long)w * h);
+  pageFillRect(buffer, WIDTH, HEIGHT, x, y, w, h, color);
+}
+
+void OledDisplay::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+  RENDER_COUNT(this, hLines, 1);
+  if (getRotation() != 0) {
+    Adafruit_SSD1306::drawFastHLine(x, y, w, color);
+    return;
+  }
+  if (w > 0) RENDER_COUNT(this, pixels, w);
+  pageFillRect(buffer, WIDTH, HEIGHT, x, y, w, 1, color);
+}
+
+void OledDisplay::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+  RENDER_COUNT(this, vLines, 1);
+  if (getRotation() != 0) {
+    Adafruit_SSD1306::drawFastVLine(x, y, h, color);
+    return;
+  }
+  if (h > 0) RENDER_COUNT(this, pixels, h);
+  pageFillRect(buffer, WIDTH, HEIGHT, x, y, 1, h, color);
+}
+
+void OledDisplay::fillRoundRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t r, uint16_t color) {
+  RENDER_COUNT(this, roundRects, 1);
+  
+  // Mismo límite de radio que Adafruit_GFX, para que radios equivalentes
+  // compartan entrada en la caché
+  int16_t maxRadius = ((w < h) ? w : h) / 2;
+  if (r > maxRadius) r = maxRadius;
+  
+  const uint8_t* mask = nullptr;
+  if (getRotation() == 0) mask = roundRectCache.get(w, h, r);
+  if (mask == nullptr) {
+    // Rotado, tamaño inválido o demasiado grande para la caché
+    Adafruit_SSD1306::fillRoundRect(x, y, w, h, r, color);
+    return;
+  }
+  RENDER_COUNT(this, pixels, (unsigned long)w * h);
+  pageBlit(buffer, WIDTH, HEIGHT, mask, w, (h + 7) / 8, x, y, color);
+}
+
+#ifdef RENDER_BENCHMARK
+// ==================== CONTADORES DE DIBUJO ====================
+// Los píxeles se cuentan solo donde se escriben (drawPixel y los rellenos por
+// spans) para no contarlos dos veces cuando una primitiva se apoya en otra
+
+void OledDisplay::drawPixel(int16_t x, int16_t y, uint16_t color) {
+  renderStats.pixelCalls++;
+  renderStats.pixels++;
+  Adafruit_SSD1306::drawPixel(x, y, color);
+}
+
+void OledDisplay::drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) {
+  renderStats.lines++;
+  Adafruit_SSD1306::drawLine(x0, y0, x1, y1, color);
+}
+
+size_t OledDisplay::write(uint8_t c) {
+  renderStats.chars++;
+  return Adafruit_SSD1306::write(c);
+}
+
+void OledDisplay::clearDisplay() {
+  renderStats.clears++;
+  Adafruit_SSD1306::clearDisplay();
+}
+
+void OledDisplay::fillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint16_t color) {
+  renderStats.triangles++;
+  Adafruit_SSD1306::fillTriangle(x0, y0, x1, y1, x2, y2, color);
+}
+#endif
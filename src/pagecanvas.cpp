@@ -0,0 +1,69 @@
+#include "pagecanvas.h"
+#include "spritecache.h"
+
+void PageCanvas::setWindow(int16_t x, int16_t y, int16_t w, int16_t h) {
+  originX = x;
+  originY = y;
+  canvasW = _width = w;
+  canvasH = _height = h;
+}
+
+void PageCanvas::drawPixel(int16_t x, int16_t y, uint16_t color) {
+  x -= originX;
+  y -= originY;
+  if (x < 0 || y < 0 || x >= canvasW || y >= canvasH) return;
+  uint8_t* b = &bitmap[(y / 8) * canvasW + x];
+  uint8_t bit = 1 << (y & 7);
+  switch (color) {
+    case SSD1306_WHITE: *b |= bit; break;
+    case SSD1306_BLACK: *b &= ~bit; break;
+    case SSD1306_INVERSE: *b ^= bit; break;
+  }
+}
+
+void PageCanvas::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+  pageFillRect(bitmap, canvasW, canvasH, x - originX, y - originY, w, h, color);
+}
+
+void PageCanvas::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+  pageFillRect(bitmap, canvasW, canvasH, x - originX, y - originY, w, 1, color);
+}
+
+void PageCanvas::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+  pageFillRect(bitmap, canvasW, canvasH, x - originX, y - originY, 1, h, color);
+}
+
+void PageCanvas::fillScreen(uint16_t color) {
+  // Por spans y no con memset: las filas de relleno de la última página
+  // deben quedar a 0 para que pageBlit no las copie
+  pageFillRect(bitmap, canvasW, canvasH, 0, 0, canvasW, canvasH, color);
+}
+
+void PageCanvas::fillRoundRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t r, uint16_t color) {
+  // Mismo límite de radio que Adafruit_GFX (ver OledDisplay::fillRoundRect)
+  int16_t maxRadius = ((w < h) ? w : h) / 2;
+  if (r > maxRadius) r = maxRadius;
+  
+  const uint8_t* mask = nullptr;
+  if (roundRects != nullptr) mask = roundRects->get(w, h, r);
+  if (mask == nullptr) {
+    Adafruit_GFX::fillRoundRect(x, y, w, h, r, color);
+    return;
+  }
+  pageBlit(bitmap, canvasW, canvasH, mask, w, (h + 7) / 8, x - originX, y - originY, color);
+}
+
+void PageCanvas::fillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                              int16_t x2, int16_t y2, uint16_t color) {
+  bool eyelid = (y0 == y1 && y2 >= y0 && (x2 == x0 || x2 == x1));
+  if (eyelids != nullptr && eyelid) {
+    int16_t left = min(x0, x1);
+    const uint8_t* heights = eyelids->get(abs(x1 - x0), y2 - y0, x2 == left);
+    if (heights != nullptr) {
+      pageFillColumns(bitmap, canvasW, canvasH, left - originX, y0 - originY,
+                      heights, abs(x1 - x0) + 1, color);
+      return;
+    }
+  }
+  Adafruit_GFX::fillTriangle(x0, y0, x1, y1, x2, y2, color);
+}
@@ -0,0 +1,151 @@
+#include "pagespan.h"
+
+// Acceso por palabras a un buffer de bytes sin romper el aliasing estricto
+typedef uint32_t __attribute__((may_alias)) span_word_t;
+
+void pageFillSpan(uint8_t* dst, int16_t n, uint8_t mask, uint16_t color) {
+  if (n <= 0 || mask == 0) return;
+  
+  // Página completa en blanco o negro: es un memset
+  if (mask == 0xFF && color != SSD1306_INVERSE) {
+    memset(dst, color == SSD1306_WHITE ? 0xFF : 0x00, n);
+    return;
+  }
+  
+  // Bytes sueltos hasta alinear a 4
+  while (n > 0 && ((uintptr_t)dst & 3) != 0) {
+    switch (color) {
+      case SSD1306_WHITE: *dst |= mask; break;
+      case SSD1306_BLACK: *dst &= ~mask; break;
+      case SSD1306_INVERSE: *dst ^= mask; break;
+    }
+    dst++;
+    n--;
+  }
+  
+  // Cuatro columnas por palabra
+  uint32_t wordMask = mask * 0x01010101UL;
+  span_word_t* word = (span_word_t*)dst;
+  int16_t words = n >> 2;
+  switch (color) {
+    case SSD1306_WHITE:
+      for (int16_t i = 0; i < words; i++) word[i] |= wordMask;
+      break;
+    case SSD1306_BLACK:
+      for (int16_t i = 0; i < words; i++) word[i] &= ~wordMask;
+      break;
+    case SSD1306_INVERSE:
+      for (int16_t i = 0; i < words; i++) word[i] ^= wordMask;
+      break;
+  }
+  dst += words << 2;
+  n &= 3;
+  
+  // Cola
+  while (n-- > 0) {
+    switch (color) {
+      case SSD1306_WHITE: *dst |= mask; break;
+      case SSD1306_BLACK: *dst &= ~mask; break;
+      case SSD1306_INVERSE: *dst ^= mask; break;
+    }
+    dst++;
+  }
+}
+
+void pageFillRect(uint8_t* buf, int16_t width, int16_t height,
+                  int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+  // Recorte (anchos y altos negativos no dibujan nada, como en Adafruit)
+  if (w <= 0 || h <= 0) return;
+  int16_t x1 = x + w;
+  int16_t y1 = y + h;
+  if (x < 0) x = 0;
+  if (y < 0) y = 0;
+  if (x1 > width) x1 = width;
+  if (y1 > height) y1 = height;
+  if (x >= x1 || y >= y1) return;
+  
+  w = x1 - x;
+  int16_t firstPage = y >> 3;
+  int16_t lastPage = (y1 - 1) >> 3;
+  uint8_t* row = buf + firstPage * width + x;
+  
+  for (int16_t page = firstPage; page <= lastPage; page++) {
+    // Filas cubiertas dentro de esta página
+    uint8_t mask = 0xFF;
+    if (page == firstPage) mask &= 0xFF << (y & 7);
+    if (page == lastPage) mask &= 0xFF >> (7 - ((y1 - 1) & 7));
+    pageFillSpan(row, w, mask, color);
+    row += width;
+  }
+}
+
+void pageBlit(uint8_t* buf, int16_t width, int16_t height,
+              const uint8_t* src, int16_t w, int16_t pages,
+              int16_t x, int16_t y, uint16_t color) {
+  int16_t bufPages = (height + 7) / 8;
+  
+  // Recorte horizontal
+  int16_t colStart = max(0, -x);
+  int16_t colEnd = min((int)w, width - x);
+  if (colStart >= colEnd) return;
+  
+  // Desplazamiento vertical dentro de la página (0 = alineado, copia directa)
+  int16_t page0 = (y >= 0) ? (y / 8) : -((7 - y) / 8);
+  uint8_t shift = y - page0 * 8;
+  
+  for (int16_t p = 0; p < pages; p++) {
+    const uint8_t* col = src + p * w;
+    int16_t pageLo = page0 + p;
+    int16_t pageHi = pageLo + 1;
+    uint8_t* lo = (pageLo >= 0 && pageLo < bufPages) ? buf + pageLo * width + x : nullptr;
+    uint8_t* hi = (shift != 0 && pageHi >= 0 && pageHi < bufPages) ? buf + pageHi * width + x : nullptr;
+    
+    for (int16_t c = colStart; c < colEnd; c++) {
+      uint8_t bits = col[c];
+      if (bits == 0) continue;
+      uint8_t bitsLo = bits << shift;
+      uint8_t bitsHi = bits >> (8 - shift);
+      switch (color) {
+        case SSD1306_WHITE:
+          if (lo) lo[c] |= bitsLo;
+          if (hi) hi[c] |= bitsHi;
+          break;
+        case SSD1306_BLACK:
+          if (lo) lo[c] &= ~bitsLo;
+          if (hi) hi[c] &= ~bitsHi;
+          break;
+        case SSD1306_INVERSE:
+          if (lo) lo[c] ^= bitsLo;
+          if (hi) hi[c] ^= bitsHi;
+          break;
+      }
+    }
+  }
+}
+
+void pageFillColumns(uint8_t* buf, int16_t width, int16_t height,
+                     int16_t x, int16_t y, const uint8_t* heights, int16_t n,
+                     uint16_t color) {
+  for (int16_t c = 0; c < n; c++) {
+    int16_t cx = x + c;
+    if (cx < 0 || cx >= width) continue;
+    int16_t top = max((int)y, 0);
+    int16_t bottom = min(y + heights[c], (int)height);  // Exclusivo
+    if (top >= bottom) continue;
+    
+    int16_t firstPage = top >> 3;
+    int16_t lastPage = (bottom - 1) >> 3;
+    uint8_t* dst = buf + firstPage * width + cx;
+    for (int16_t page = firstPage; page <= lastPage; page++) {
+      uint8_t mask = 0xFF;
+      if (page == firstPage) mask &= 0xFF << (top & 7);
+      if (page == lastPage) mask &= 0xFF >> (7 - ((bottom - 1) & 7));
+      switch (color) {
+        case SSD1306_WHITE: *dst |= mask; break;
+        case SSD1306_BLACK: *dst &= ~mask; break;
+        case SSD1306_INVERSE: *dst ^= mask; break;
+      }
+      dst += width;
+    }
+  }
+}
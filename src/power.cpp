@@ -0,0 +1,48 @@
+#include "power.h"
+#ifdef ARDUINO_ARCH_ESP32
+#include <esp_sleep.h>
+#include <driver/gpio.h>
+#endif
+
+PowerManager::PowerManager() {
+  wakePin = 0;
+  sleepCount = 0;
+  sleptMillis = 0;
+}
+
+void PowerManager::initialize(uint8_t pin) {
+  wakePin = pin;
+}
+
+bool PowerManager::canSleep(unsigned long ms) const {
+  if (ms < LIGHT_SLEEP_MIN_MS) return false;
+  // Con el botón pulsado despertaría al instante
+  return digitalRead(wakePin) != LOW;
+}
+
+SleepResult PowerManager::lightSleep(unsigned long ms) {
+  if (!canSleep(ms)) return SLEEP_SKIPPED;
+  
+  unsigned long start = millis();
+  SleepResult result = SLEEP_TIMER;
+  
+#ifdef ARDUINO_ARCH_ESP32
+  esp_sleep_enable_timer_wakeup((uint64_t)ms * 1000ULL);
+  gpio_wakeup_enable((gpio_num_t)wakePin, GPIO_INTR_LOW_LEVEL);
+  esp_sleep_enable_gpio_wakeup();
+  
+  esp_light_sleep_start();
+  
+  if (esp_sleep_get_wakeup_cause() == ESP_SLEEP_WAKEUP_GPIO) result = SLEEP_BUTTON;
+  // Devolver el pin a su uso normal con digitalRead
+  gpio_wakeup_disable((gpio_num_t)wakePin);
+  esp_sleep_disable_wakeup_source(ESP_SLEEP_WAKEUP_TIMER);
+  esp_sleep_disable_wakeup_source(ESP_SLEEP_WAKEUP_GPIO);
+#else
+  delay(ms);
+#endif
+  
+  sleepCount++;
+  sleptMillis += millis() - start;
+  return result;
+}
@@ -0,0 +1,179 @@
+#include "scheduler.h"
+#include "governor.h"
+
+// ==================== ESCENA ====================
+
+Scene::Scene(const char* name) : name(name) {
+  resetStats();
+}
+
+void Scene::recordTick(unsigned long micros) {
+  ticks++;
+  totalMicros += micros;
+  if (micros > maxMicros) maxMicros = micros;
+  if (micros > frameInterval() * 1000UL) overruns++;
+}
+
+void Scene::resetStats() {
+  ticks = 0;
+  totalMicros = 0;
+  maxMicros = 0;
+  overruns = 0;
+}
+
+// ==================== SCHEDULER ====================
+
+Scheduler::Scheduler() {
+  taskCount = 0;
+  scene = nullptr;
+  overlay = nullptr;
+  gestures = nullptr;
+  now = 0;
+}
+
+int Scheduler::addTask(const char* name, TaskFunction run, unsigned long period, unsigned long now) {
+  if (taskCount >= SCHEDULER_MAX_TASKS) return -1;
+  Task& task = tasks[taskCount];
+  task.name = name;
+  task.run = run;
+  task.period = period;
+  task.nextRun = now + period;
+  task.runs = 0;
+  task.lateRuns = 0;
+  task.totalMicros = 0;
+  task.maxMicros = 0;
+  return taskCount++;
+}
+
+void Scheduler::setScene(Scene* next) {
+  if (next == scene) return;
+  if (scene != nullptr) scene->exit();
+  scene = next;
+  if (scene != nullptr) scene->enter(now);
+}
+
+void Scheduler::interrupt(Scene* next) {
+  if (next == overlay) return;
+  if (overlay != nullptr) overlay->exit();
+  overlay = next;
+  if (overlay != nullptr) {
+    overlay->enter(now);
+  } else if (scene != nullptr) {
+    scene->resume(now);
+  }
+}
+
+void Scheduler::runTasks() {
+  for (uint8_t i = 0; i < taskCount; i++) {
+    Task& task = tasks[i];
+    if ((long)(now - task.nextRun) < 0) continue;
+
+    // Con un periodo entero de retraso no se recuperan las ejecuciones
+    // perdidas: se cuenta y se vuelve a contar el periodo desde ahora
+    if (task.period > 0 && now - task.nextRun >= task.period) {
+      task.lateRuns++;
+      task.nextRun = now + task.period;
+    } else {
+      task.nextRun += task.period;
+    }
+
+    unsigned long start = micros();
+    task.run(now);
+    unsigned long took = micros() - start;
+    task.runs++;
+    task.totalMicros += took;
+    if (took > task.maxMicros) task.maxMicros = took;
+  }
+}
+
+void Scheduler::tick(unsigned long time) {
+  now = time;
+  runTasks();
+
+  Scene* active = getActiveScene();
+  if (active == nullptr) return;
+
+  // El coste se apunta a la escena con la que empezó el tick
+  unsigned long start = micros();
+  if (gestures != nullptr) {
+    ButtonEvent event;
+    while (gestures->next(now, event)) getActiveScene()->input(event);
+  }
+  getActiveScene()->update(now);
+  getActiveScene()->render();
+  active->recordTick(micros() - start);
+}
+
+void Scheduler::logStats() {
+  for (uint8_t i = 0; i < taskCount; i++) {
+    const Task& task = tasks[i];
+    log_i("Task %s - Runs:%lu Late:%lu Avg:%luus Max:%luus", task.name, task.runs, task.lateRuns,
+          task.runs ? task.totalMicros / task.runs : 0, task.maxMicros);
+  }
+  Scene* active = getActiveScene();
+  if (active != nullptr) {
+    log_i("Scene %s - Ticks:%lu Avg:%luus Max:%luus Over:%lu", active->getName(), active->getTicks(),
+          active->getAverageMicros(), active->getMaxMicros(), active->getOverruns());
+  }
+}
+
+void Scheduler::resetStats() {
+  for (uint8_t i = 0; i < taskCount; i++) {
+    tasks[i].runs = 0;
+    tasks[i].lateRuns = 0;
+    tasks[i].totalMicros = 0;
+    tasks[i].maxMicros = 0;
+  }
+  if (scene != nullptr) scene->resetStats();
+  if (overlay != nullptr) overlay->resetStats();
+}
+
+// ==================== PANTALLA TEMPORAL ====================
+
+TimedOverlay::TimedOverlay(const char* name) : Scene(name) {
+  draw = nullptr;
+  done = nullptr;
+  duration = 0;
+  shownAt = 0;
+  skippable = false;
+  drawn = false;
+}
+
+void TimedOverlay::show(unsigned long now, OverlayAction drawScreen, unsigned long time,
+                        bool canSkip, OverlayAction onDone) {
+  draw = drawScreen;
+  done = onDone;
+  duration = time;
+  skippable = canSkip;
+  shownAt = now;
+  drawn = false;
+}
+
+void TimedOverlay::enter(unsigned long now) {
+  shownAt = now;
+  drawn = false;
+}
+
+void TimedOverlay::input(const ButtonEvent& event) {
+  if (!skippable) return;
+  if (event.type != BUTTON_SHORT_PRESS && event.type != BUTTON_LONG_PRESS) return;
+  // Una pulsación que empezó antes de mostrarse era para la escena anterior
+  if ((long)(event.at - event.duration - shownAt) < 0) return;
+  if (done != nullptr) done();
+}
+
+void TimedOverlay::update(unsigned long now) {
+  if (now - shownAt < duration) return;
+  if (done != nullptr) done();
+}
+
+void TimedOverlay::render() {
+  if (drawn || draw == nullptr) return;
+  draw();
+  drawn = true;
+}
+
+unsigned long TimedOverlay::frameInterval() const {
+  // Ya dibujada solo queda esperar: basta con vigilar el fin y el botón
+  return drawn ? FRAME_MS_MAX : FRAME_MS_MENU;
+}
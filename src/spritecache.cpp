@@ -0,0 +1,119 @@
+#include "spritecache.h"
+#include "pagecanvas.h"
+
+RoundRectCache::RoundRectCache() {
+  useClock = 0;
+  clear();
+  resetStats();
+}
+
+void RoundRectCache::clear() {
+  for (int i = 0; i < SPRITE_CACHE_ENTRIES; i++) {
+    entries[i].valid = false;
+    entries[i].lastUse = 0;
+  }
+}
+
+void RoundRectCache::resetStats() {
+  hits = 0;
+  misses = 0;
+}
+
+const uint8_t* RoundRectCache::get(int16_t w, int16_t h, int16_t r) {
+  if (w <= 0 || h <= 0 || r < 0) return nullptr;
+  if ((int32_t)w * ((h + 7) / 8) > SPRITE_MAX_BYTES) return nullptr;
+  
+  useClock++;
+  Entry* victim = &entries[0];
+  for (int i = 0; i < SPRITE_CACHE_ENTRIES; i++) {
+    Entry& e = entries[i];
+    if (e.valid && e.w == w && e.h == h && e.r == r) {
+      hits++;
+      e.lastUse = useClock;
+      return e.bits;
+    }
+    // Hueco libre o la entrada usada hace más tiempo
+    if (!e.valid) {
+      if (victim->valid) victim = &e;
+    } else if (victim->valid && e.lastUse < victim->lastUse) {
+      victim = &e;
+    }
+  }
+  
+  // Fallo: rasterizar con el mismo algoritmo de Adafruit_GFX sobre un lienzo de páginas
+  misses++;
+  memset(victim->bits, 0, w * ((h + 7) / 8));
+  PageCanvas canvas(victim->bits, w, h);
+  canvas.fillRoundRect(0, 0, w, h, r, SSD1306_WHITE);
+  victim->w = w;
+  victim->h = h;
+  victim->r = r;
+  victim->valid = true;
+  victim->lastUse = useClock;
+  return victim->bits;
+}
+
+EyelidCache::EyelidCache() {
+  useClock = 0;
+  clear();
+  resetStats();
+}
+
+void EyelidCache::clear() {
+  for (int i = 0; i < EYELID_CACHE_ENTRIES; i++) {
+    entries[i].valid = false;
+    entries[i].lastUse = 0;
+  }
+}
+
+void EyelidCache::resetStats() {
+  hits = 0;
+  misses = 0;
+}
+
+const uint8_t* EyelidCache::get(int16_t w, int16_t h, bool apexLeft) {
+  if (w < 0 || w > EYELID_MAX_COLUMNS || h < 0 || h >= 255) return nullptr;
+  
+  useClock++;
+  Entry* victim = &entries[0];
+  for (int i = 0; i < EYELID_CACHE_ENTRIES; i++) {
+    Entry& e = entries[i];
+    if (e.valid && e.w == w && e.h == h && e.apexLeft == apexLeft) {
+      hits++;
+      e.lastUse = useClock;
+      return e.heights;
+    }
+    if (!e.valid) {
+      if (victim->valid) victim = &e;
+    } else if (victim->valid && e.lastUse < victim->lastUse) {
+      victim = &e;
+    }
+  }
+  
+  // Fallo: recorrer las filas como Adafruit_GFX::fillTriangle con
+  // (0,0)-(w,0) arriba y el vértice en (0,h) o (w,h)
+  misses++;
+  uint8_t* heights = victim->heights;
+  if (h == 0) {
+    // Los tres vértices en la misma fila: una sola línea
+    memset(heights, 1, w + 1);
+  } else {
+    memset(heights, 0, w + 1);
+    int16_t x2 = apexLeft ? 0 : w;
+    int32_t dx12 = x2 - w;  // Lado de (w,0) al vértice
+    int32_t dx02 = x2;      // Lado de (0,0) al vértice
+    for (int16_t y = 0; y <= h; y++) {
+      int16_t a = w + dx12 * y / h;
+      int16_t b = dx02 * y / h;
+      if (a > b) { int16_t t = a; a = b; b = t; }
+      // Las filas bajan, así que la última que toca cada columna marca su altura
+      for (int16_t x = a; x <= b; x++) heights[x] = y + 1;
+    }
+  }
+  victim->w = w;
+  victim->h = h;
+  victim->apexLeft = apexLeft;
+  victim->valid = true;
+  victim->lastUse = useClock;
+  return heights;
+}
@@ -0,0 +1,151 @@
+#include "storage.h"
+#include <Preferences.h>
+
+StorageManager storage;
+
+StorageManager::StorageManager() {
+  slotCount = 0;
+  batchOpen = false;
+  batchStart = 0;
+  batches = 0;
+  writes = 0;
+  skipped = 0;
+  dropped = 0;
+#ifdef ARDUINO_ARCH_ESP32
+  queue = nullptr;
+  task = nullptr;
+#endif
+}
+
+#ifdef ARDUINO_ARCH_ESP32
+bool StorageManager::begin(uint8_t priority) {
+  if (task != nullptr) return true;
+
+  queue = xQueueCreate(STORAGE_QUEUE_SIZE, sizeof(StorageWrite));
+  if (queue == nullptr) return false;
+
+  // Si ya había algo pendiente (batchOpen) la tarea empieza por ese lote
+  if (xTaskCreate(taskEntry, "storage", STORAGE_STACK, this, priority, &task) != pdPASS) {
+    vQueueDelete(queue);
+    queue = nullptr;
+    task = nullptr;
+    return false;
+  }
+  return true;
+}
+
+void StorageManager::taskEntry(void* arg) {
+  StorageManager* self = static_cast<StorageManager*>(arg);
+  StorageWrite write;
+  for (;;) {
+    if (!self->batchOpen) {
+      xQueueReceive(self->queue, &write, portMAX_DELAY);
+      self->stage(write);
+    }
+
+    // Lo que llegue durante la ventana va al mismo lote
+    TickType_t until = xTaskGetTickCount() + pdMS_TO_TICKS(STORAGE_BATCH_MS);
+    for (;;) {
+      TickType_t left = until - xTaskGetTickCount();
+      if ((int32_t)left <= 0 || xQueueReceive(self->queue, &write, left) != pdTRUE) break;
+      self->stage(write);
+    }
+    self->commit();
+  }
+}
+#else
+bool StorageManager::begin(uint8_t priority) {
+  return false;
+}
+#endif
+
+void StorageManager::put(const char* space, const char* key, int32_t value, bool isBool) {
+  StorageWrite write;
+  strncpy(write.space, space, STORAGE_NAME_LEN - 1);
+  write.space[STORAGE_NAME_LEN - 1] = '\0';
+  strncpy(write.key, key, STORAGE_NAME_LEN - 1);
+  write.key[STORAGE_NAME_LEN - 1] = '\0';
+  write.value = value;
+  write.isBool = isBool;
+
+#ifdef ARDUINO_ARCH_ESP32
+  if (queue != nullptr) {
+    // Nunca esperar: con la cola llena se pierde la escritura y se cuenta
+    if (xQueueSend(queue, &write, 0) != pdTRUE) dropped++;
+    return;
+  }
+#endif
+
+  // Sin tarea: el lote queda pendiente hasta update()
+  stage(write);
+}
+
+void StorageManager::stage(const StorageWrite& write) {
+  Slot* slot = nullptr;
+  for (uint8_t i = 0; i < slotCount; i++) {
+    if (strcmp(slots[i].write.key, write.key) == 0 && strcmp(slots[i].write.space, write.space) == 0) {
+      slot = &slots[i];
+      break;
+    }
+  }
+
+  if (slot == nullptr) {
+    if (slotCount >= STORAGE_SLOTS) {
+      // Sin hueco para recordarla: se escribe ya, fuera de lote
+      Preferences prefs;
+      prefs.begin(write.space, false);
+      if (write.isBool) prefs.putBool(write.key, write.value != 0);
+      else prefs.putInt(write.key, write.value);
+      prefs.end();
+      writes++;
+      return;
+    }
+    slot = &slots[slotCount++];
+    slot->known = false;
+    slot->dirty = false;
+  }
+
+  slot->write = write;
+  bool wasDirty = slot->dirty;
+  slot->dirty = !(slot->known && slot->stored == write.value);
+  if (!slot->dirty && !wasDirty) skipped++;
+
+  if (slot->dirty && !batchOpen) {
+    batchOpen = true;
+    batchStart = millis();
+  }
+}
+
+void StorageManager::commit() {
+  batchOpen = false;
+
+  bool wrote = false;
+  for (uint8_t i = 0; i < slotCount; i++) {
+    if (!slots[i].dirty) continue;
+
+    // Todas las claves pendientes del namespace con una sola apertura
+    const char* space = slots[i].write.space;
+    Preferences prefs;
+    prefs.begin(space, false);
+    for (uint8_t j = i; j < slotCount; j++) {
+      Slot& slot = slots[j];
+      if (!slot.dirty || strcmp(slot.write.space, space) != 0) continue;
+      if (slot.write.isBool) prefs.putBool(slot.write.key, slot.write.value != 0);
+      else prefs.putInt(slot.write.key, slot.write.value);
+      slot.stored = slot.write.value;
+      slot.known = true;
+      slot.dirty = false;
+      writes++;
+    }
+    prefs.end();
+    wrote = true;
+  }
+  if (wrote) batches++;
+}
+
+void StorageManager::update(unsigned long now) {
+#ifdef ARDUINO_ARCH_ESP32
+  if (task != nullptr) return;
+#endif
+  if (batchOpen && now - batchStart >= STORAGE_BATCH_MS) commit();
+}
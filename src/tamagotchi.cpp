@@ -21,19 +21,23 @@ Tamagotchi::Tamagotchi() {
   lastMinuteUpdate = 0;
   sleepStartTime = 0;
   lastSleepTick = 0;
+  minuteCounter = 0;
+  clock = &systemClock;
   wasHungry = false;
   wasBored = false;
   wasSleepy = false;
 }
 
-void Tamagotchi::initialize() {
-  prefs.begin("tamagotchi", false);
+void Tamagotchi::initialize(Clock* clk) {
+  clock = clk;
+  prefs.begin("tamagotchi", true); // Solo lectura
   loadStats();
   // Leer si los juegos están desbloqueados
   memoryGameUnlocked = prefs.getBool("memgame", false);
   ticTacToeUnlocked = prefs.getBool("tictactoe", false);
+  prefs.end();
   
-  lastMinuteUpdate = millis();
+  lastMinuteUpdate = clock->now();
   
   if (isSleeping) {
     // Si estaba durmiendo al reiniciar, despertar
@@ -54,7 +58,7 @@ bool Tamagotchi::buyFood(int type) {
   }
   if (coins < cost) {
     showInsufficientCoins = true;
-    insufficientCoinsTimer = millis();
+    insufficientCoinsTimer = clock->now();
     return false;
   }
   coins -= cost;
@@ -70,7 +74,7 @@ bool Tamagotchi::buyFood(int type) {
   }
   
   showHappyFace = true;
-  happyFaceTimer = millis();
+  happyFaceTimer = clock->now();
   saveStats();
   return true;
 }
@@ -80,14 +84,14 @@ bool Tamagotchi::buyMemoryGame() {
   if (memoryGameUnlocked) return false;
   if (coins < 100) {
     showInsufficientCoins = true;
-    insufficientCoinsTimer = millis();
+    insufficientCoinsTimer = clock->now();
     return false;
   }
   coins -= 100;
   memoryGameUnlocked = true;
-  prefs.putBool("memgame", true);
+  storage.putBool("tamagotchi", "memgame", true);
   showHappyFace = true;
-  happyFaceTimer = millis();
+  happyFaceTimer = clock->now();
   saveStats();
   return true;
 }
@@ -97,20 +101,20 @@ bool Tamagotchi::buyTicTacToeGame() {
   if (ticTacToeUnlocked) return false;
   if (coins < 100) {
     showInsufficientCoins = true;
-    insufficientCoinsTimer = millis();
+    insufficientCoinsTimer = clock->now();
     return false;
   }
   coins -= 100;
   ticTacToeUnlocked = true;
-  prefs.putBool("tictactoe", true);
+  storage.putBool("tamagotchi", "tictactoe", true);
   showHappyFace = true;
-  happyFaceTimer = millis();
+  happyFaceTimer = clock->now();
   saveStats();
   return true;
 }
 
 void Tamagotchi::update() {
-  unsigned long currentTime = millis();
+  unsigned long currentTime = clock->now();
   
   // Gestionar cara enfadada temporal (3 segundos)
   if (showAngryFace && (currentTime - angryFaceTimer >= 3000)) {
@@ -130,7 +134,7 @@ void Tamagotchi::update() {
   // Si está durmiendo
   if (isSleeping) {
     // Cada 5 segundos, aumentar sueño en 1%
-    if (currentTime - lastSleepTick >= 5000) {
+    if (currentTime - lastSleepTick >= SLEEP_TICK_MS) {
       sleepiness = min(100, sleepiness + 1);
       lastSleepTick = currentTime;
       saveStats();
@@ -148,7 +152,7 @@ void Tamagotchi::update() {
 }
 
 void Tamagotchi::updatePerMinute() {
-  unsigned long currentTime = millis();
+  unsigned long currentTime = clock->now();
   if (currentTime - lastMinuteUpdate >= 60000) { // 60 segundos
     // Hambre pierde 1% por minuto
     hunger = max(0, hunger - 1);
@@ -173,11 +177,10 @@ void Tamagotchi::updatePerMinute() {
     }
     
     // Sueño pierde 1% cada 2 minutos (contador interno)
-    static int sleepCounter = 0;
-    sleepCounter++;
-    if (sleepCounter >= 2) {
+    minuteCounter++;
+    if (minuteCounter >= 2) {
       sleepiness = max(0, sleepiness - 1);
-      sleepCounter = 0;
+      minuteCounter = 0;
     }
     
     // Detectar si sueño llegó a 20 o menos
@@ -204,14 +207,14 @@ bool Tamagotchi::feed() {
   // Validación 1: debe tener 10 monedas (primero)
   if (coins < 10) {
     showInsufficientCoins = true;
-    insufficientCoinsTimer = millis();
+    insufficientCoinsTimer = clock->now();
     return false;
   }
   
   // Validación 2: si tiene >80% hambre (muy lleno)
   if (hunger > 80) {
     showAngryFace = true;
-    angryFaceTimer = millis();
+    angryFaceTimer = clock->now();
     return false;
   }
   
@@ -234,7 +237,7 @@ bool Tamagotchi::feed() {
   
   // Mostrar cara feliz
   showHappyFace = true;
-  happyFaceTimer = millis();
+  happyFaceTimer = clock->now();
   
   saveStats();
   return true;
@@ -280,13 +283,13 @@ bool Tamagotchi::sleep() {
   // Validación: si tiene >20% sueño (no tiene sueño)
   if (sleepiness > 20) {
     showAngryFace = true;
-    angryFaceTimer = millis();
+    angryFaceTimer = clock->now();
     return false;
   }
   
   isSleeping = true;
-  sleepStartTime = millis();
-  lastSleepTick = millis();
+  sleepStartTime = clock->now();
+  lastSleepTick = clock->now();
   saveStats();
   return true;
 }
@@ -295,12 +298,12 @@ void Tamagotchi::wakeUp() {
   // Si despierta con 60% o más de sueño, mostrar animación feliz
   if (sleepiness >= 60) {
     showHappyFace = true;
-    happyFaceTimer = millis();
+    happyFaceTimer = clock->now();
   }
   // Si despierta con 20% o menos de sueño, mostrar animación enfadado
   else if (sleepiness <= 20) {
     showAngryFace = true;
-    angryFaceTimer = millis();
+    angryFaceTimer = clock->now();
   }
   
   isSleeping = false;
@@ -308,7 +311,7 @@ void Tamagotchi::wakeUp() {
   // Al despertar: mantener sueño actual, aburrimiento +20%
   boredom = min(100, boredom + 20);
   
-  lastMinuteUpdate = millis();
+  lastMinuteUpdate = clock->now();
   saveStats();
 }
 
@@ -343,11 +346,12 @@ int Tamagotchi::getMood() const {
 }
 
 void Tamagotchi::saveStats() {
-  prefs.putInt("hunger", hunger);
-  prefs.putInt("boredom", boredom);
-  prefs.putInt("sleep", sleepiness);
-  prefs.putInt("coins", coins);
-  prefs.putBool("sleeping", isSleeping);
+  // En cola: la tarea de persistencia agrupa y solo escribe lo que cambió
+  storage.putInt("tamagotchi", "hunger", hunger);
+  storage.putInt("tamagotchi", "boredom", boredom);
+  storage.putInt("tamagotchi", "sleep", sleepiness);
+  storage.putInt("tamagotchi", "coins", coins);
+  storage.putBool("tamagotchi", "sleeping", isSleeping);
 }
 
 void Tamagotchi::loadStats() {
@@ -7,10 +7,15 @@ TapGame::TapGame() {
   difficulty = 2000;
   targetX = 64;
   targetY = 32;
+  spawnTime = 0;
   gameStartTime = 0;
+  clock = &systemClock;
+  rng = &systemRng;
 }
 
-void TapGame::initialize() {
+void TapGame::initialize(Clock* clk, Rng* rnd) {
+  clock = clk;
+  rng = rnd;
   reset();
 }
 
@@ -19,12 +24,12 @@ void TapGame::reset() {
   level = 1;
   targetActive = false;
   difficulty = 2000;
-  gameStartTime = millis();
+  gameStartTime = clock->now();
   spawnTarget();
 }
 
 void TapGame::update() {
-  unsigned long currentTime = millis();
+  unsigned long currentTime = clock->now();
   
   if (!targetActive) {
     if (currentTime - spawnTime >= difficulty) {
@@ -35,9 +40,9 @@ void TapGame::update() {
 
 void TapGame::spawnTarget() {
   targetActive = true;
-  spawnTime = millis();
-  targetX = 30 + random(68);
-  targetY = 20 + random(30);
+  spawnTime = clock->now();
+  targetX = 30 + rng->next(68);
+  targetY = 20 + rng->next(30);
 }
 
 void TapGame::registerTap() {
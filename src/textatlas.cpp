@@ -0,0 +1,22 @@
+#include "textatlas.h"
+#include "textatlasdata.h"  // Generado por tools/gentextatlas.py
+
+int16_t TextAtlas::getWidth(TextLabel label) const {
+  return pgm_read_byte(&TEXT_ATLAS_ENTRIES[label].width);
+}
+
+int16_t TextAtlas::getHeight(TextLabel label) const {
+  return pgm_read_byte(&TEXT_ATLAS_ENTRIES[label].pages) * 8;
+}
+
+void TextAtlas::draw(OledDisplay* display, TextLabel label, int16_t x, int16_t y, uint16_t color) const {
+  int16_t w = pgm_read_byte(&TEXT_ATLAS_ENTRIES[label].width);
+  int16_t pages = pgm_read_byte(&TEXT_ATLAS_ENTRIES[label].pages);
+  if (x >= OLED_WIDTH || x + w <= 0) return;
+  RENDER_COUNT(display, blits, 1);
+  RENDER_COUNT(display, pixels, (min((int)w, OLED_WIDTH - x) - max(0, -x)) * pages * 8);
+  
+  // En el ESP32 la flash está mapeada en memoria: pageBlit lee el pool directamente
+  const uint8_t* src = TEXT_ATLAS_POOL + pgm_read_word(&TEXT_ATLAS_ENTRIES[label].offset);
+  pageBlit(display->getBuffer(), OLED_WIDTH, OLED_HEIGHT, src, w, pages, x, y, color);
+}
@@ -4,12 +4,30 @@ TicTacToeGame::TicTacToeGame() {
   wins = 0;
   draws = 0;
   losses = 0;
-  reset();
+  clock = &systemClock;
+  rng = &systemRng;
+  
+  // Tablero vacío; quién empieza se decide en reset()
+  for (int y = 0; y < 3; y++) {
+    for (int x = 0; x < 3; x++) {
+      board[y][x] = CELL_EMPTY;
+    }
+  }
+  cursorX = 1;
+  cursorY = 1;
+  playerFirst = true;
+  movesCount = 0;
+  turnStartTime = 0;
+  result = RESULT_NONE;
+  state = TIC_IDLE;
 }
 
-void TicTacToeGame::initialize() {
-  prefs.begin("tictactoe", false);
+void TicTacToeGame::initialize(Clock* clk, Rng* rnd) {
+  clock = clk;
+  rng = rnd;
+  prefs.begin("tictactoe", true); // Solo lectura
   loadStats();
+  prefs.end();
   reset();
 }
 
@@ -20,9 +38,9 @@ void TicTacToeGame::loadStats() {
 }
 
 void TicTacToeGame::saveStats() {
-  prefs.putInt("wins", wins);
-  prefs.putInt("draws", draws);
-  prefs.putInt("losses", losses);
+  storage.putInt("tictactoe", "wins", wins);
+  storage.putInt("tictactoe", "draws", draws);
+  storage.putInt("tictactoe", "losses", losses);
 }
 
 void TicTacToeGame::updateStats(GameResult gameResult) {
@@ -49,10 +67,11 @@ void TicTacToeGame::reset() {
   cursorY = 1;
   
   // Decidir quién empieza aleatoriamente
-  playerFirst = random(0, 2) == 0;
+  playerFirst = rng->next(0, 2) == 0;
   
   movesCount = 0;
   result = RESULT_NONE;
+  turnStartTime = clock->now();
   
   // Estado inicial
   if (playerFirst) {
@@ -64,8 +83,8 @@ void TicTacToeGame::reset() {
 
 void TicTacToeGame::update() {
   if (state == TIC_TAMAGOTCHI_TURN) {
-    // Pequeña pausa para que no sea instantáneo
-    delay(500);
+    // Pequeña pausa para que no sea instantáneo (sin bloquear el loop)
+    if (clock->now() - turnStartTime < TIC_TAMAGOTCHI_DELAY_MS) return;
     tamagotchiMove();
     
     // Comprobar si hay ganador o empate
@@ -79,6 +98,9 @@ void TicTacToeGame::update() {
 }
 
 void TicTacToeGame::moveCursor() {
+  // Mientras piensa el Tamagotchi el cursor no se mueve
+  if (state != TIC_PLAYER_TURN) return;
+  
   // Buscar la siguiente posición vacía
   int attempts = 0;
   do {
@@ -108,6 +130,7 @@ bool TicTacToeGame::tryPlacePiece() {
     state = TIC_GAME_OVER;
   } else {
     state = TIC_TAMAGOTCHI_TURN;
+    turnStartTime = clock->now();
   }
   
   return true;
@@ -121,7 +144,7 @@ void TicTacToeGame::tamagotchiMove() {
   }
   
   // Luego intenta bloquear al jugador (85% de las veces)
-  int blockChance = random(0, 100);
+  int blockChance = rng->next(0, 100);
   if (blockChance < 85) {
     if (tryToBlock()) {
       movesCount++;
@@ -318,7 +341,7 @@ void TicTacToeGame::randomMove() {
   
   // Elegir una posición aleatoria
   if (emptyCount > 0) {
-    int choice = random(0, emptyCount);
+    int choice = rng->next(0, emptyCount);
     int x = emptyPositions[choice][0];
     int y = emptyPositions[choice][1];
     board[y][x] = CELL_TAMAGOTCHI;
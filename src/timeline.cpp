@@ -0,0 +1,77 @@
+#include "timeline.h"
+
+Timeline::Timeline() {
+  clear();
+}
+
+void Timeline::clear() {
+  count = 0;
+  nextEvent = 0;
+  length = 0;
+  startTime = 0;
+  running = false;
+  hasView = false;
+}
+
+bool Timeline::add(uint16_t at, TimelineEventType type, int16_t value, uint16_t duration) {
+  if (count >= TIMELINE_MAX_EVENTS) {
+    log_i("Timeline full, event at %u dropped", at);
+    return false;
+  }
+  
+  // Inserción ordenada; a igual instante se respeta el orden de llegada
+  int i = count;
+  while (i > 0 && events[i - 1].at > at) {
+    events[i] = events[i - 1];
+    i--;
+  }
+  events[i].at = at;
+  events[i].type = type;
+  events[i].value = value;
+  events[i].duration = duration;
+  count++;
+  
+  if (at > length) length = at;
+  return true;
+}
+
+void Timeline::setLength(uint16_t ms) {
+  if (ms > length) length = ms;
+}
+
+void Timeline::start(unsigned long now) {
+  startTime = now;
+  nextEvent = 0;
+  running = true;
+  hasView = false;
+}
+
+void Timeline::cancel() {
+  nextEvent = count;
+  running = false;
+}
+
+bool Timeline::poll(unsigned long now, TimelineEvent& out) {
+  if (!running || nextEvent >= count) return false;
+  if (now - startTime < events[nextEvent].at) return false;
+  
+  out = events[nextEvent++];
+  if (out.type != TL_TONE) {
+    view = out;
+    hasView = true;
+  }
+  return true;
+}
+
+bool Timeline::isRunning(unsigned long now) {
+  if (running && nextEvent >= count && now - startTime >= length) {
+    running = false;
+  }
+  return running;
+}
+
+bool Timeline::getView(TimelineEvent& out) const {
+  if (!hasView) return false;
+  out = view;
+  return true;
+}
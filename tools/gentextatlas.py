@@ -0,0 +1,121 @@
+"""
+Rasteriza las etiquetas de include/textlabels.h con la fuente clásica de
+Adafruit GFX (glcdfont.c) y genera textatlasdata.h: los bitmaps en el
+formato de páginas del SSD1306 (un byte = 8 filas de una columna), en
+PROGMEM, listos para que TextAtlas::draw() los copie desde la flash.
+
+Desde PlatformIO se ejecuta antes de compilar (extra_scripts en
+platformio.ini) y escribe en el directorio de build. A mano:
+
+    python3 tools/gentextatlas.py glcdfont.c include/textlabels.h salida/textatlasdata.h
+"""
+
+import os
+import re
+import sys
+
+LABEL_RE = re.compile(r'^\s*TEXT_LABEL\(\s*(\w+)\s*,\s*"([^"]*)"\s*,\s*(\d+)\s*\)', re.M)
+
+
+def read_labels(path):
+    with open(path, encoding="utf-8") as f:
+        labels = [(name, text, int(size)) for name, text, size in LABEL_RE.findall(f.read())]
+    if not labels:
+        raise SystemExit("gentextatlas: no hay etiquetas en %s" % path)
+    return labels
+
+
+def read_font(path):
+    # Tabla font[] de glcdfont.c: 5 bytes por carácter, bit 0 = fila de arriba
+    with open(path, encoding="latin-1") as f:
+        source = f.read()
+    start = source.index("{", source.index("font[]")) + 1
+    body = source[start:source.index("}", start)]
+    body = re.sub(r"/\*.*?\*/", "", body, flags=re.S)
+    body = re.sub(r"//[^\n]*", "", body)
+    values = [int(v, 0) for v in re.findall(r"0[xX][0-9A-Fa-f]+|\d+", body)]
+    if len(values) < 256 * 5:
+        raise SystemExit("gentextatlas: %s no parece glcdfont.c (%d bytes)" % (path, len(values)))
+    return values
+
+
+def rasterize(text, size, font):
+    # Igual que Adafruit_GFX::drawChar con fondo transparente: 5 columnas de
+    # glifo y una de separación vacía; a tamaño 2 cada píxel ocupa 2x2
+    columns = []
+    for code in text.encode("latin-1"):
+        for line in font[code * 5:code * 5 + 5] + [0]:
+            columns.extend([line] * size)
+    pages = []
+    for page in range(size):
+        row = []
+        for line in columns:
+            bits = 0
+            for bit in range(8):
+                if line >> ((page * 8 + bit) // size) & 1:
+                    bits |= 1 << bit
+            row.append(bits)
+        pages.append(row)
+    return len(columns), pages
+
+
+def generate(font_path, labels_path, out_path):
+    font = read_font(font_path)
+    pool = []
+    entries = []
+    for name, text, size in read_labels(labels_path):
+        width, pages = rasterize(text, size, font)
+        if width > 255:
+            raise SystemExit("gentextatlas: %s mide %d px (máximo 255)" % (name, width))
+        entries.append((len(pool), width, size, name, text))
+        for row in pages:
+            pool.extend(row)
+
+    lines = [
+        "// Generado por tools/gentextatlas.py a partir de glcdfont.c y textlabels.h: no editar",
+        "#ifndef TEXTATLASDATA_H",
+        "#define TEXTATLASDATA_H",
+        "",
+        "static const uint8_t TEXT_ATLAS_POOL[%d] PROGMEM = {" % len(pool),
+    ]
+    for i in range(0, len(pool), 16):
+        lines.append("  " + ", ".join("0x%02X" % b for b in pool[i:i + 16]) + ",")
+    lines.append("};")
+    lines.append("")
+    lines.append("static const TextAtlasEntry TEXT_ATLAS_ENTRIES[LABEL_COUNT] PROGMEM = {")
+    for offset, width, size, name, text in entries:
+        lines.append('  {%d, %d, %d},  // %s "%s"' % (offset, width, size, name, text))
+    lines.append("};")
+    lines.append("")
+    lines.append("#endif")
+    content = "\n".join(lines) + "\n"
+
+    # No tocar el fichero si no cambia: evita recompilar textatlas.cpp
+    if os.path.exists(out_path):
+        with open(out_path, encoding="utf-8") as f:
+            if f.read() == content:
+                return
+    os.makedirs(os.path.dirname(out_path) or ".", exist_ok=True)
+    with open(out_path, "w", encoding="utf-8") as f:
+        f.write(content)
+    print("gentextatlas: %d etiquetas, %d bytes en flash -> %s" % (len(entries), len(pool), out_path))
+
+
+try:
+    Import("env")  # noqa: F821 (lo define PlatformIO al ejecutar el script)
+except NameError:
+    env = None
+
+if env is not None:
+    font_path = os.path.join(env.subst("$PROJECT_LIBDEPS_DIR"), env.subst("$PIOENV"),
+                             "Adafruit GFX Library", "glcdfont.c")
+    if not os.path.exists(font_path):
+        raise SystemExit("gentextatlas: no se encuentra %s (falta Adafruit GFX en lib_deps)" % font_path)
+    out_dir = os.path.join(env.subst("$BUILD_DIR"), "generated")
+    generate(font_path, os.path.join(env.subst("$PROJECT_INCLUDE_DIR"), "textlabels.h"),
+             os.path.join(out_dir, "textatlasdata.h"))
+    env.Append(CPPPATH=[out_dir])
+elif __name__ == "__main__":
+    if len(sys.argv) != 4:
+        raise SystemExit(__doc__)
+    generate(sys.argv[1], sys.argv[2], sys.argv[3])